@@ -0,0 +1,448 @@
+#include "Math/Float16.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "TexturePackerKernels.h"
+#include "TexturePackerResize.h"
+#include "TexturePackerSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TexturePacker
+{
+namespace
+{
+/** Best wall time of NumRuns calls, in milliseconds */
+double TimeBestMs(const int32 NumRuns, TFunctionRef<void()> Body)
+{
+	double Best = MAX_dbl;
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Body();
+		Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+	}
+	return Best * 1000.0;
+}
+
+FString FormatTiming(const double Ms, const int64 NumPixels)
+{
+	return FString::Printf(TEXT("%.2f ms (%.0f Mpix/s)"), Ms, NumPixels / (Ms * 1000.0));
+}
+
+void FillRandom(TArray64<uint8>& Bytes, const int64 Num, const int32 Seed)
+{
+	FRandomStream Random(Seed);
+	Bytes.SetNumUninitialized(Num);
+	for (int64 Idx = 0; Idx + 4 <= Num; Idx += 4)
+	{
+		const uint32 Value = Random.GetUnsignedInt();
+		FMemory::Memcpy(&Bytes[Idx], &Value, 4);
+	}
+}
+
+/** Channel as the per pixel loop the kernels replaced described it */
+struct FLegacyChannel
+{
+	const TArray64<uint8>* Bytes = nullptr;
+	int32 BytesPerPixel = 4;
+	int32 ChannelOffset = 0;
+	bool b16BitChannel = false;
+	bool bConvertSRGB = false;
+	bool bInvert = false;
+};
+
+/** Per pixel conversion of the old PackTexture loop, every flag is tested again for every pixel */
+uint8 LegacyGetByte(const int64 PixelIdx, const FLegacyChannel& Channel)
+{
+	const TArray64<uint8>& Bytes = *Channel.Bytes;
+	if (Channel.b16BitChannel)
+	{
+		const uint8 Higher = Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset];
+		const uint8 Lower = Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset + 1];
+		const uint16 Value = (Higher << 8) | Lower;
+		return FMath::FloorToInt(float(Value) / float(MAX_uint16) * MAX_uint8);
+	}
+
+	const uint8 B = Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset];
+	if (Channel.bConvertSRGB)
+	{
+		float BLin = sRGBToLinearTable[B];
+		BLin = Channel.bInvert ? 1.f - BLin : BLin;
+
+		return uint8(FMath::FloorToInt(BLin * 255.999f));
+	}
+	return Channel.bInvert ? MAX_uint8 - B : B;
+}
+
+/** The old PackTexture pixel loop, BGRA8 destination */
+void LegacyPack(const FLegacyChannel (&Channels)[4], const int64 NumPixels, TArray64<uint8>& Bytes)
+{
+	for (int64 PixelIdx = 0; PixelIdx < NumPixels; ++PixelIdx)
+	{
+		uint8* Pixel = &Bytes[PixelIdx * 4];
+
+		Pixel[0] = LegacyGetByte(PixelIdx, Channels[0]);
+		Pixel[1] = LegacyGetByte(PixelIdx, Channels[1]);
+		Pixel[2] = LegacyGetByte(PixelIdx, Channels[2]);
+		Pixel[3] = LegacyGetByte(PixelIdx, Channels[3]);
+	}
+}
+
+/** Channel of a BGRA8 source, blue is copied, green inverted, red converted from sRGB and alpha both */
+FChannelSource MakeBGRA8Channel(const int32 ChannelIdx)
+{
+	FChannelSource Source;
+	Source.Stride = 4;
+	Source.bInvert = ChannelIdx == 1 || ChannelIdx == 3;
+	Source.bConvertSRGB = ChannelIdx >= 2;
+	return Source;
+}
+
+/** Rows of a BGRA8 pack, converted into own planes and interleaved like every band of the pack does */
+void PackBGRA8Rows(const uint8* Source,
+				   const FChannelConverter (&Converters)[4],
+				   const int32 Size,
+				   const int32 RowStart,
+				   const int32 RowEnd,
+				   uint8* Pixels)
+{
+	const int64 FirstPixel = int64(RowStart) * Size;
+	const int64 NumPixels = int64(RowEnd - RowStart) * Size;
+
+	TArray64<uint8> Planes;
+	Planes.SetNumUninitialized(NumPixels * 4);
+	for (int32 ChannelIdx = 0; ChannelIdx < 4; ++ChannelIdx)
+	{
+		Converters[ChannelIdx].Run(
+			Source + FirstPixel * 4 + ChannelIdx, NumPixels, Planes.GetData() + ChannelIdx * NumPixels);
+	}
+	InterleaveBGRA8(Planes.GetData(),
+					Planes.GetData() + NumPixels,
+					Planes.GetData() + NumPixels * 2,
+					Planes.GetData() + NumPixels * 3,
+					NumPixels,
+					Pixels + FirstPixel * 4);
+}
+
+/** The same per pixel approach extended to every sample type, baseline of the converter matrix */
+uint8 GenericGetByte(const int64 PixelIdx, const FChannelSource& Source)
+{
+	const uint8* Sample = Source.Data + PixelIdx * Source.Stride;
+	float Value;
+	switch (Source.SampleType)
+	{
+		case ESampleType::U16:
+			Value = *reinterpret_cast<const uint16*>(Sample) / float(MAX_uint16);
+			break;
+		case ESampleType::F16:
+		{
+			FFloat16 Half;
+			Half.Encoded = *reinterpret_cast<const uint16*>(Sample);
+			Value = Half.GetFloat();
+			break;
+		}
+		default:
+			Value = Source.bConvertSRGB ? sRGBToLinearTable[*Sample] : *Sample / 255.f;
+			break;
+	}
+
+	Value = Source.bInvert ? 1.f - Value : Value;
+	Value = Source.bTonemapHdr ? TonemapHdr(Value) : FMath::Clamp(Value, 0.f, 1.f);
+	return uint8(FMath::RoundToInt(Value * 255.f));
+}
+
+const TCHAR* GetSampleTypeName(const ESampleType SampleType)
+{
+	switch (SampleType)
+	{
+		case ESampleType::U16:
+			return TEXT("U16");
+		case ESampleType::F16:
+			return TEXT("F16");
+		default:
+			return TEXT("U8");
+	}
+}
+
+/** Overrides MaxWorkerThreads for the lifetime of the scope */
+struct FScopedMaxWorkerThreads
+{
+	int32 Previous;
+
+	explicit FScopedMaxWorkerThreads(const int32 MaxWorkerThreads)
+	{
+		UTexturePackerSettings* Settings = GetMutableDefault<UTexturePackerSettings>();
+		Previous = Settings->MaxWorkerThreads;
+		Settings->MaxWorkerThreads = MaxWorkerThreads;
+	}
+
+	~FScopedMaxWorkerThreads()
+	{
+		GetMutableDefault<UTexturePackerSettings>()->MaxWorkerThreads = Previous;
+	}
+};
+
+/**
+ * @brief Time conversion of one channel to an 8 bit plane
+ *
+ * The generic path runs on one thread like the loop it stands for, the selected converter runs on every thread count.
+ *
+ * @return One line with all timings and the speedup of every converter run over the generic path
+ */
+FString BenchmarkChannel(const FChannelSource& Source, const int32 Size, TArray64<uint8>& Plane)
+{
+	const int64 NumPixels = int64(Size) * Size;
+	const bool bPlanar = Source.Stride == GetSampleSize(Source.SampleType);
+	const double GenericMs = TimeBestMs(3,
+										[&]()
+										{
+											for (int64 PixelIdx = 0; PixelIdx < NumPixels; ++PixelIdx)
+											{
+												Plane[PixelIdx] = GenericGetByte(PixelIdx, Source);
+											}
+										});
+
+	FString Line = FString::Printf(TEXT("%dx%d %s %s%s%s%s: generic %s"),
+								   Size,
+								   Size,
+								   GetSampleTypeName(Source.SampleType),
+								   bPlanar ? TEXT("planar") : TEXT("interleaved"),
+								   Source.bConvertSRGB ? TEXT(" sRGB") : TEXT(""),
+								   Source.bTonemapHdr ? TEXT(" tonemap") : TEXT(""),
+								   Source.bInvert ? TEXT(" invert") : TEXT(""),
+								   *FormatTiming(GenericMs, NumPixels));
+
+	const FChannelConverter Converter = SelectChannelConverter(Source);
+	auto ConvertRows = [&](const int32 RowStart, const int32 RowEnd)
+	{
+		const int64 FirstPixel = int64(RowStart) * Size;
+		Converter.Run(
+			Source.Data + FirstPixel * Source.Stride, int64(RowEnd - RowStart) * Size, Plane.GetData() + FirstPixel);
+	};
+
+	// 0 lets ParallelForRowBands use every task graph worker
+	for (const int32 MaxThreads : {1, 2, 4, 0})
+	{
+		FScopedMaxWorkerThreads ScopedMaxThreads(MaxThreads);
+		const double KernelMs = TimeBestMs(3, [&]() { ParallelForRowBands(Size, ConvertRows); });
+		Line += FString::Printf(TEXT(", %d threads %s (%.1fx)"),
+								GetNumBandWorkers(Size),
+								*FormatTiming(KernelMs, NumPixels),
+								GenericMs / KernelMs);
+	}
+	return Line;
+}
+}  // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInterleaveBenchmark,
+								 "TexturePacker.Benchmarks.Interleave",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Packs a BGRA8 source into BGRA8 with the old per pixel loop and with the channel kernels. Every 8 bit conversion is
+ * part of the timing, see MakeBGRA8Channel.
+ */
+bool FInterleaveBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Sizes[] = {1024, 4096, 8192};
+	for (const int32 Size : Sizes)
+	{
+		const int64 NumPixels = int64(Size) * Size;
+		TArray64<uint8> Source;
+		FillRandom(Source, NumPixels * 4, Size);
+
+		FLegacyChannel LegacyChannels[4];
+		FChannelConverter Converters[4];
+		for (int32 ChannelIdx = 0; ChannelIdx < 4; ++ChannelIdx)
+		{
+			const FChannelSource ChannelSource = MakeBGRA8Channel(ChannelIdx);
+			Converters[ChannelIdx] = SelectChannelConverter(ChannelSource);
+
+			FLegacyChannel& Legacy = LegacyChannels[ChannelIdx];
+			Legacy.Bytes = &Source;
+			Legacy.ChannelOffset = ChannelIdx;
+			Legacy.bInvert = ChannelSource.bInvert;
+			Legacy.bConvertSRGB = ChannelSource.bConvertSRGB;
+		}
+
+		TArray64<uint8> LegacyPixels;
+		LegacyPixels.SetNumUninitialized(NumPixels * 4);
+		const double LegacyMs = TimeBestMs(3, [&]() { LegacyPack(LegacyChannels, NumPixels, LegacyPixels); });
+
+		TArray64<uint8> Pixels;
+		Pixels.SetNumUninitialized(NumPixels * 4);
+		auto PackRows = [&](const int32 RowStart, const int32 RowEnd)
+		{ PackBGRA8Rows(Source.GetData(), Converters, Size, RowStart, RowEnd, Pixels.GetData()); };
+
+		double KernelMs;
+		{
+			FScopedMaxWorkerThreads SingleThread(1);
+			KernelMs = TimeBestMs(3, [&]() { ParallelForRowBands(Size, PackRows); });
+		}
+		const double ParallelMs = TimeBestMs(3, [&]() { ParallelForRowBands(Size, PackRows); });
+
+		// sRGB rounding of the tables differs from the old floor, nothing may be further off than that
+		int32 MaxDifference = 0;
+		for (int64 Idx = 0; Idx < NumPixels * 4; ++Idx)
+		{
+			MaxDifference = FMath::Max(MaxDifference, FMath::Abs(int32(Pixels[Idx]) - int32(LegacyPixels[Idx])));
+		}
+		TestTrue(FString::Printf(TEXT("%d: kernels match the per pixel loop"), Size), MaxDifference <= 1);
+
+		AddInfo(FString::Printf(TEXT("%dx%d: per pixel loop %s, kernels %s (%.1fx), kernels on %d threads %s (%.1fx)"),
+								Size,
+								Size,
+								*FormatTiming(LegacyMs, NumPixels),
+								*FormatTiming(KernelMs, NumPixels),
+								LegacyMs / KernelMs,
+								GetNumBandWorkers(Size),
+								*FormatTiming(ParallelMs, NumPixels),
+								LegacyMs / ParallelMs));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConvertKernelsBenchmark,
+								 "TexturePacker.Benchmarks.ConvertKernels",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Converts one channel to 8 bit for every combination of sample type, planar or interleaved layout, sRGB or tonemap
+ * and invert, at 1K and 4K, with the generic per pixel path and with the specialized converters.
+ */
+bool FConvertKernelsBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Sizes[] = {1024, 4096};
+	for (const int32 Size : Sizes)
+	{
+		const int64 NumPixels = int64(Size) * Size;
+
+		// Room for four 16 bit channels. Halves are kept positive and below 2, so clamp and tonemap both see values
+		// above one
+		TArray64<uint8> Unorm;
+		TArray64<uint8> Half;
+		FillRandom(Unorm, NumPixels * 8, Size);
+		FillRandom(Half, NumPixels * 8, Size + 1);
+		uint16* HalfSamples = reinterpret_cast<uint16*>(Half.GetData());
+		for (int64 Idx = 0; Idx < NumPixels * 4; ++Idx)
+		{
+			HalfSamples[Idx] &= 0x3FFF;
+		}
+
+		TArray64<uint8> Plane;
+		Plane.SetNumUninitialized(NumPixels);
+
+		for (const ESampleType SampleType : {ESampleType::U8, ESampleType::U16, ESampleType::F16})
+		{
+			// sRGB only applies to 8 bit samples and tonemapping only to halves
+			const int32 NumConvertModes = SampleType == ESampleType::U16 ? 1 : 2;
+			for (const int32 NumChannels : {1, 4})
+			{
+				for (int32 ConvertMode = 0; ConvertMode < NumConvertModes; ++ConvertMode)
+				{
+					for (const bool bInvert : {false, true})
+					{
+						FChannelSource Source;
+						Source.Data = SampleType == ESampleType::F16 ? Half.GetData() : Unorm.GetData();
+						Source.Stride = NumChannels * GetSampleSize(SampleType);
+						Source.SampleType = SampleType;
+						Source.bConvertSRGB = SampleType == ESampleType::U8 && ConvertMode == 1;
+						Source.bTonemapHdr = SampleType == ESampleType::F16 && ConvertMode == 1;
+						Source.bInvert = bInvert;
+						AddInfo(BenchmarkChannel(Source, Size, Plane));
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBandScalingBenchmark,
+								 "TexturePacker.Benchmarks.BandScaling",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Packs an 8K BGRA8 source and resizes one of its sRGB channels with 1, 2, 4, 8 and 16 band workers. Every run must
+ * give the same bytes as the serial path, which fills the whole image in one call without bands.
+ */
+bool FBandScalingBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Size = 8192;
+	// Non integer factor, so neighbouring destination rows have different taps
+	const int32 ResizedSize = 5461;
+	const int64 NumPixels = int64(Size) * Size;
+	const int64 NumResizedPixels = int64(ResizedSize) * ResizedSize;
+
+	TArray64<uint8> Source;
+	FillRandom(Source, NumPixels * 4, Size);
+
+	FChannelConverter Converters[4];
+	for (int32 ChannelIdx = 0; ChannelIdx < 4; ++ChannelIdx)
+	{
+		Converters[ChannelIdx] = SelectChannelConverter(MakeBGRA8Channel(ChannelIdx));
+	}
+	const FResampler Resampler(FResampleFormat::Channel(TSF_BGRA8, 2, true),
+							   Size,
+							   Size,
+							   ResizedSize,
+							   ResizedSize,
+							   ETexturePackerResizeFilter::Lanczos3);
+
+	TArray64<uint8> SerialPixels;
+	TArray64<uint8> SerialResized;
+	SerialPixels.SetNumUninitialized(NumPixels * 4);
+	SerialResized.SetNumUninitialized(NumResizedPixels);
+	PackBGRA8Rows(Source.GetData(), Converters, Size, 0, Size, SerialPixels.GetData());
+	Resampler.ResizeRows(Source.GetData() + 2, 0, ResizedSize, SerialResized.GetData());
+
+	TArray64<uint8> Pixels;
+	TArray64<uint8> Resized;
+	Pixels.SetNumUninitialized(NumPixels * 4);
+	Resized.SetNumUninitialized(NumResizedPixels);
+	auto PackRows = [&](const int32 RowStart, const int32 RowEnd)
+	{ PackBGRA8Rows(Source.GetData(), Converters, Size, RowStart, RowEnd, Pixels.GetData()); };
+	auto ResizeRows = [&](const int32 RowStart, const int32 RowEnd)
+	{
+		Resampler.ResizeRows(
+			Source.GetData() + 2, RowStart, RowEnd, Resized.GetData() + int64(RowStart) * ResizedSize);
+	};
+
+	double SingleThreadPackMs = 0.0;
+	double SingleThreadResizeMs = 0.0;
+	for (const int32 MaxThreads : {1, 2, 4, 8, 16})
+	{
+		FScopedMaxWorkerThreads ScopedMaxThreads(MaxThreads);
+		const double PackMs = TimeBestMs(3, [&]() { ParallelForRowBands(Size, PackRows); });
+		const double ResizeMs = TimeBestMs(3, [&]() { ParallelForRowBands(ResizedSize, ResizeRows); });
+		if (MaxThreads == 1)
+		{
+			SingleThreadPackMs = PackMs;
+			SingleThreadResizeMs = ResizeMs;
+		}
+
+		TestTrue(FString::Printf(TEXT("%d threads: packed pixels match the serial path"), MaxThreads),
+				 FMemory::Memcmp(Pixels.GetData(), SerialPixels.GetData(), Pixels.Num()) == 0);
+		TestTrue(FString::Printf(TEXT("%d threads: resized pixels match the serial path"), MaxThreads),
+				 FMemory::Memcmp(Resized.GetData(), SerialResized.GetData(), Resized.Num()) == 0);
+
+		AddInfo(FString::Printf(TEXT("%d threads (%d workers): pack %dx%d %s (%.1fx), resize to %dx%d %s (%.1fx)"),
+								MaxThreads,
+								GetNumBandWorkers(Size),
+								Size,
+								Size,
+								*FormatTiming(PackMs, NumPixels),
+								SingleThreadPackMs / PackMs,
+								ResizedSize,
+								ResizedSize,
+								*FormatTiming(ResizeMs, NumResizedPixels),
+								SingleThreadResizeMs / ResizeMs));
+	}
+
+	return true;
+}
+}  // namespace TexturePacker
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,222 @@
+#include "Math/Float16.h"
+#include "Misc/AutomationTest.h"
+#include "TexturePackerKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TexturePacker
+{
+namespace
+{
+float DecodeSRGB(const float Encoded)
+{
+	return Encoded <= 0.04045f ? Encoded / 12.92f : FMath::Pow((Encoded + 0.055f) / 1.055f, 2.4f);
+}
+
+float EncodeSRGB(const float Linear)
+{
+	return Linear <= 0.0031308f ? Linear * 12.92f : FMath::Pow(Linear, 1.f / 2.4f) * 1.055f - 0.055f;
+}
+
+float HalfBitsToFloat(const uint16 Bits)
+{
+	FFloat16 Half;
+	Half.Encoded = Bits;
+	return Half.GetFloat();
+}
+
+/** Same clamp as the unorm tables, NaN ends up black */
+float ClampUnorm(const float Value)
+{
+	return Value > 0.f ? FMath::Min(Value, 1.f) : 0.f;
+}
+
+/**
+ * @brief Compare every entry of a table with its float reference
+ *
+ * Reports the number of entries off by more than one step and the first of them, so a broken table gives one error
+ * instead of thousands.
+ *
+ * @param Entry Table value of an index, in destination steps
+ * @param Reference Exact value of an index, in destination steps, not rounded
+ */
+void TestTable(FAutomationTestBase& Test,
+			   const TCHAR* Name,
+			   const int32 Num,
+			   TFunctionRef<float(int32 Index)> Entry,
+			   TFunctionRef<float(int32 Index)> Reference)
+{
+	int32 NumFailed = 0;
+	int32 FirstFailed = INDEX_NONE;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (FMath::Abs(Entry(Index) - Reference(Index)) > 1.f)
+		{
+			FirstFailed = NumFailed == 0 ? Index : FirstFailed;
+			++NumFailed;
+		}
+	}
+
+	if (NumFailed > 0)
+	{
+		Test.AddError(FString::Printf(TEXT("%s: %d of %d entries off by more than 1, first %d is %f not %f"),
+									  Name,
+									  NumFailed,
+									  Num,
+									  FirstFailed,
+									  Entry(FirstFailed),
+									  Reference(FirstFailed)));
+	}
+}
+
+/** Halves are compared by their bits, one step is one unit in the last place */
+void TestHalfTable(FAutomationTestBase& Test,
+				   const TCHAR* Name,
+				   const int32 Num,
+				   const uint16* Table,
+				   TFunctionRef<float(int32 Index)> Reference)
+{
+	TestTable(
+		Test,
+		Name,
+		Num,
+		[Table](const int32 Index) { return float(Table[Index]); },
+		[&Reference](const int32 Index) { return float(FFloat16(Reference(Index)).Encoded); });
+}
+}  // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FColorTablesTest,
+								 "TexturePacker.Kernels.ColorTables",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FColorTablesTest::RunTest(const FString& Parameters)
+{
+	const FColorTables& Tables = FColorTables::Get();
+
+	TestTable(
+		*this,
+		TEXT("Identity"),
+		256,
+		[&](const int32 Index) { return float(Tables.Identity[Index]); },
+		[](const int32 Index) { return float(Index); });
+	TestTable(
+		*this,
+		TEXT("Invert"),
+		256,
+		[&](const int32 Index) { return float(Tables.Invert[Index]); },
+		[](const int32 Index) { return float(MAX_uint8 - Index); });
+	TestTable(
+		*this,
+		TEXT("SRGBToLinear"),
+		256,
+		[&](const int32 Index) { return float(Tables.SRGBToLinear[Index]); },
+		[](const int32 Index) { return DecodeSRGB(Index / 255.f) * 255.f; });
+	TestTable(
+		*this,
+		TEXT("SRGBToLinearInverted"),
+		256,
+		[&](const int32 Index) { return float(Tables.SRGBToLinearInverted[Index]); },
+		[](const int32 Index) { return (1.f - DecodeSRGB(Index / 255.f)) * 255.f; });
+	TestTable(
+		*this,
+		TEXT("LinearToSRGB"),
+		FColorTables::LinearToSRGBSize,
+		[&](const int32 Index) { return float(Tables.LinearToSRGB[Index]); },
+		[](const int32 Index) { return EncodeSRGB(Index / float(FColorTables::LinearToSRGBSize - 1)) * 255.f; });
+	TestTable(
+		*this,
+		TEXT("Unorm16To8"),
+		65536,
+		[&](const int32 Index) { return float(Tables.Unorm16To8[Index]); },
+		[](const int32 Index) { return Index / float(MAX_uint16) * 255.f; });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWideColorTablesTest,
+								 "TexturePacker.Kernels.WideColorTables",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWideColorTablesTest::RunTest(const FString& Parameters)
+{
+	const FWideColorTables& Tables = FWideColorTables::Get();
+
+	TestTable(
+		*this,
+		TEXT("Unorm8To16"),
+		256,
+		[&](const int32 Index) { return float(Tables.Unorm8To16[Index]); },
+		[](const int32 Index) { return Index / 255.f * float(MAX_uint16); });
+	TestTable(
+		*this,
+		TEXT("SRGBToLinear16"),
+		256,
+		[&](const int32 Index) { return float(Tables.SRGBToLinear16[Index]); },
+		[](const int32 Index) { return DecodeSRGB(Index / 255.f) * float(MAX_uint16); });
+
+	for (int32 bConvertSRGB = 0; bConvertSRGB < 2; ++bConvertSRGB)
+	{
+		for (int32 bInvert = 0; bInvert < 2; ++bInvert)
+		{
+			TestHalfTable(*this,
+						  *FString::Printf(TEXT("Unorm8ToHalf[%d][%d]"), bConvertSRGB, bInvert),
+						  256,
+						  Tables.Unorm8ToHalf[bConvertSRGB][bInvert],
+						  [=](const int32 Index)
+						  {
+							  const float Linear = bConvertSRGB ? DecodeSRGB(Index / 255.f) : Index / 255.f;
+							  return bInvert ? 1.f - Linear : Linear;
+						  });
+		}
+	}
+
+	for (int32 bInvert = 0; bInvert < 2; ++bInvert)
+	{
+		TestHalfTable(*this,
+					  *FString::Printf(TEXT("Unorm16ToHalf[%d]"), bInvert),
+					  65536,
+					  Tables.Unorm16ToHalf[bInvert],
+					  [=](const int32 Index)
+					  {
+						  const float Unorm = Index / float(MAX_uint16);
+						  return bInvert ? 1.f - Unorm : Unorm;
+					  });
+	}
+
+	for (int32 bTonemap = 0; bTonemap < 2; ++bTonemap)
+	{
+		auto Reference = [bTonemap](const int32 Index)
+		{
+			const float Value = HalfBitsToFloat(uint16(Index));
+			return bTonemap ? TonemapHdr(Value) : ClampUnorm(Value);
+		};
+		TestTable(
+			*this,
+			*FString::Printf(TEXT("HalfToUnorm8[%d]"), bTonemap),
+			65536,
+			[&](const int32 Index) { return float(Tables.HalfToUnorm8[bTonemap][Index]); },
+			[&](const int32 Index) { return Reference(Index) * 255.f; });
+		TestTable(
+			*this,
+			*FString::Printf(TEXT("HalfToUnorm16[%d]"), bTonemap),
+			65536,
+			[&](const int32 Index) { return float(Tables.HalfToUnorm16[bTonemap][Index]); },
+			[&](const int32 Index) { return Reference(Index) * float(MAX_uint16); });
+	}
+
+	// NaN has no meaningful one minus, the table keeps whatever the conversion gives
+	TestHalfTable(*this,
+				  TEXT("HalfInvert"),
+				  65536,
+				  Tables.HalfInvert,
+				  [&Tables](const int32 Index)
+				  {
+					  const float Value = HalfBitsToFloat(uint16(Index));
+					  return FMath::IsNaN(Value) ? HalfBitsToFloat(Tables.HalfInvert[Index]) : 1.f - Value;
+				  });
+
+	return true;
+}
+}  // namespace TexturePacker
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
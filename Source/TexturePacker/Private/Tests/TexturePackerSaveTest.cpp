@@ -0,0 +1,106 @@
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "TexturePackerSave.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TexturePacker
+{
+namespace
+{
+/** Same file the save session writes a package to */
+FString GetPackageFilename(const UPackage* Package)
+{
+	return FPaths::ConvertRelativePathToFull(
+		FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()));
+}
+
+/** Small texture in a new package under /Temp, so nothing outside the saved directory is written */
+UTexture2D* MakeTempTexture(const int32 Index)
+{
+	UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Temp/TexturePackerSaveTest/T_Packed_%d"), Index));
+	UTexture2D* Texture = NewObject<UTexture2D>(Package,
+												*FString::Printf(TEXT("T_Packed_%d"), Index),
+												RF_Public | RF_Standalone | RF_Transactional);
+	Texture->Source.Init(4, 4, 1, 1, TSF_BGRA8);
+	return Texture;
+}
+
+void DestroyTempTexture(UTexture2D* Texture)
+{
+	UPackage* Package = Texture->GetOutermost();
+	IFileManager::Get().Delete(*GetPackageFilename(Package), false, true, true);
+	Texture->ClearFlags(RF_Standalone);
+	Texture->MarkAsGarbage();
+	Package->MarkAsGarbage();
+}
+}  // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveSessionSourceControlTest,
+								 "TexturePacker.Save.SourceControlBatching",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Flush a session of packages whose files are partly controlled and partly new. However many packages there are,
+ * the session must send one status query, one checkout of the controlled files and one mark for add of the others.
+ */
+bool FSaveSessionSourceControlTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumPackages = 8;
+
+	TArray<UTexture2D*> Textures;
+	TSet<FString> ControlledFiles;
+	TSet<FString> NewFiles;
+	for (int32 Index = 0; Index < NumPackages; ++Index)
+	{
+		UTexture2D* Texture = MakeTempTexture(Index);
+		Textures.Add(Texture);
+		(Index % 2 == 0 ? ControlledFiles : NewFiles).Add(GetPackageFilename(Texture->GetOutermost()));
+	}
+
+	FFakePackSourceControl SourceControl(ControlledFiles);
+	{
+		FPackSaveSession SaveSession(&SourceControl);
+		for (UTexture2D* Texture : Textures)
+		{
+			SaveSession.Add(Texture->GetOutermost(), Texture);
+		}
+		TestEqual(TEXT("Queued packages"), SaveSession.Num(), NumPackages);
+
+		const TArray<FString> Failed = SaveSession.Flush();
+		TestEqual(TEXT("Failed packages"), Failed.Num(), 0);
+		TestEqual(TEXT("Queued packages after flush"), SaveSession.Num(), 0);
+
+		// Status query, checkout and mark for add
+		TestEqual(TEXT("Source control requests"), SaveSession.GetNumSourceControlRequests(), 3);
+	}
+
+	TestEqual(TEXT("Checked out files"), SourceControl.GetCheckedOutFiles().Num(), ControlledFiles.Num());
+	TestTrue(TEXT("Only controlled files are checked out"),
+			 SourceControl.GetCheckedOutFiles().Difference(ControlledFiles).Num() == 0);
+	TestEqual(TEXT("Added files"), SourceControl.GetAddedFiles().Num(), NewFiles.Num());
+	TestTrue(TEXT("Only new files are marked for add"), SourceControl.GetAddedFiles().Difference(NewFiles).Num() == 0);
+
+	// Every file is controlled and checked out now, saving again only queries their status
+	{
+		FPackSaveSession SaveSession(&SourceControl);
+		for (UTexture2D* Texture : Textures)
+		{
+			SaveSession.Add(Texture->GetOutermost(), Texture);
+		}
+		SaveSession.Flush();
+		TestEqual(TEXT("Source control requests of a second save"), SaveSession.GetNumSourceControlRequests(), 1);
+	}
+
+	for (UTexture2D* Texture : Textures)
+	{
+		DestroyTempTexture(Texture);
+	}
+	return true;
+}
+}  // namespace TexturePacker
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -1,692 +1,1358 @@
 #include "TexturePacker.h"
 
-#include "Algo/Transform.h"
+#include "Algo/AllOf.h"
+#include "Algo/Copy.h"
 #include "AssetRegistryModule.h"
 #include "ContentBrowserModule.h"
+#include "Engine/AssetManager.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "IContentBrowserSingleton.h"
-#include "ISourceControlModule.h"
-#include "ISourceControlOperation.h"
-#include "ISourceControlProvider.h"
-#include "SourceControlOperations.h"
 #include "Modules/ModuleManager.h"
-#include "UObject/SavePackage.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "TexturePackerAsync.h"
+#include "TexturePackerAutoRepack.h"
+#include "TexturePackerDerivedData.h"
+#include "TexturePackerJob.h"
+#include "TexturePackerKernels.h"
+#include "TexturePackerResize.h"
+#include "TexturePackerSave.h"
+#include "TexturePackerSettings.h"
+#include "TexturePackerSourceCache.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
-#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Layout/SSeparator.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/SWindow.h"
 #include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
 
 #define LOCTEXT_NAMESPACE "TexturePacker"
 
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePacker, Log, All);
+
 namespace TexturePacker
 {
-// clang-format off
-// Copied form Math\Color.cpp. Wasn't in exported symbols
-float sRGBToLinearTable[256] =
+FText ChannelToText(EChannel Channel)
 {
-	0.0f,
-	0.000303526983548838f, 0.000607053967097675f, 0.000910580950646512f, 0.00121410793419535f, 0.00151763491774419f,
-	0.00182116190129302f, 0.00212468888484186f, 0.0024282158683907f, 0.00273174285193954f, 0.00303526983548838f,
-	0.00334653564113713f, 0.00367650719436314f, 0.00402471688178252f, 0.00439144189356217f, 0.00477695332960869f,
-	0.005181516543916f, 0.00560539145834456f, 0.00604883284946662f, 0.00651209061157708f, 0.00699540999852809f,
-	0.00749903184667767f, 0.00802319278093555f, 0.0085681254056307f, 0.00913405848170623f, 0.00972121709156193f,
-	0.0103298227927056f, 0.0109600937612386f, 0.0116122449260844f, 0.012286488094766f, 0.0129830320714536f,
-	0.0137020827679224f, 0.0144438433080002f, 0.0152085141260192f, 0.0159962930597398f, 0.0168073754381669f,
-	0.0176419541646397f, 0.0185002197955389f, 0.0193823606149269f, 0.0202885627054049f, 0.0212190100154473f,
-	0.0221738844234532f, 0.02315336579873f, 0.0241576320596103f, 0.0251868592288862f, 0.0262412214867272f,
-	0.0273208912212394f, 0.0284260390768075f, 0.0295568340003534f, 0.0307134432856324f, 0.0318960326156814f,
-	0.0331047661035236f, 0.0343398063312275f, 0.0356013143874111f, 0.0368894499032755f, 0.0382043710872463f,
-	0.0395462347582974f, 0.0409151963780232f, 0.0423114100815264f, 0.0437350287071788f, 0.0451862038253117f,
-	0.0466650857658898f, 0.0481718236452158f, 0.049706565391714f, 0.0512694577708345f, 0.0528606464091205f,
-	0.0544802758174765f, 0.0561284894136735f, 0.0578054295441256f, 0.0595112375049707f, 0.0612460535624849f,
-	0.0630100169728596f, 0.0648032660013696f, 0.0666259379409563f, 0.0684781691302512f, 0.070360094971063f,
-	0.0722718499453493f, 0.0742135676316953f, 0.0761853807213167f, 0.0781874210336082f, 0.0802198195312533f,
-	0.0822827063349132f, 0.0843762107375113f, 0.0865004612181274f, 0.0886555854555171f, 0.0908417103412699f,
-	0.0930589619926197f, 0.0953074657649191f, 0.0975873462637915f, 0.0998987273569704f, 0.102241732185838f,
-	0.104616483176675f, 0.107023102051626f, 0.109461709839399f, 0.1119324268857f, 0.114435372863418f,
-	0.116970666782559f, 0.119538426999953f, 0.122138771228724f, 0.124771816547542f, 0.127437679409664f,
-	0.130136475651761f, 0.132868320502552f, 0.135633328591233f, 0.138431613955729f, 0.141263290050755f,
-	0.144128469755705f, 0.147027265382362f, 0.149959788682454f, 0.152926150855031f, 0.155926462553701f,
-	0.158960833893705f, 0.162029374458845f, 0.16513219330827f, 0.168269398983119f, 0.171441099513036f,
-	0.174647402422543f, 0.17788841473729f, 0.181164242990184f, 0.184474993227387f, 0.187820771014205f,
-	0.191201681440861f, 0.194617829128147f, 0.198069318232982f, 0.201556252453853f, 0.205078735036156f,
-	0.208636868777438f, 0.212230756032542f, 0.215860498718652f, 0.219526198320249f, 0.223227955893977f,
-	0.226965872073417f, 0.23074004707378f, 0.23455058069651f, 0.238397572333811f, 0.242281120973093f,
-	0.246201325201334f, 0.250158283209375f, 0.254152092796134f, 0.258182851372752f, 0.262250655966664f,
-	0.266355603225604f, 0.270497789421545f, 0.274677310454565f, 0.278894261856656f, 0.283148738795466f,
-	0.287440836077983f, 0.291770648154158f, 0.296138269120463f, 0.300543792723403f, 0.304987312362961f,
-	0.309468921095997f, 0.313988711639584f, 0.3185467763743f, 0.323143207347467f, 0.32777809627633f,
-	0.332451534551205f, 0.337163613238559f, 0.341914423084057f, 0.346704054515559f, 0.351532597646068f,
-	0.356400142276637f, 0.361306777899234f, 0.36625259369956f, 0.371237678559833f, 0.376262121061519f,
-	0.381326009488037f, 0.386429431827418f, 0.39157247577492f, 0.396755228735618f, 0.401977777826949f,
-	0.407240209881218f, 0.41254261144808f, 0.417885068796976f, 0.423267667919539f, 0.428690494531971f,
-	0.434153634077377f, 0.439657171728079f, 0.445201192387887f, 0.450785780694349f, 0.456411021020965f,
-	0.462076997479369f, 0.467783793921492f, 0.473531493941681f, 0.479320180878805f, 0.485149937818323f,
-	0.491020847594331f, 0.496932992791578f, 0.502886455747457f, 0.50888131855397f, 0.514917663059676f,
-	0.520995570871595f, 0.527115123357109f, 0.533276401645826f, 0.539479486631421f, 0.545724458973463f,
-	0.552011399099209f, 0.558340387205378f, 0.56471150325991f, 0.571124827003694f, 0.577580437952282f,
-	0.584078415397575f, 0.590618838409497f, 0.597201785837643f, 0.603827336312907f, 0.610495568249093f,
-	0.617206559844509f, 0.623960389083534f, 0.630757133738175f, 0.637596871369601f, 0.644479679329661f,
-	0.651405634762384f, 0.658374814605461f, 0.665387295591707f, 0.672443154250516f, 0.679542466909286f,
-	0.686685309694841f, 0.693871758534824f, 0.701101889159085f, 0.708375777101046f, 0.71569349769906f,
-	0.723055126097739f, 0.730460737249286f, 0.737910405914797f, 0.745404206665559f, 0.752942213884326f,
-	0.760524501766589f, 0.768151144321824f, 0.775822215374732f, 0.783537788566466f, 0.791297937355839f,
-	0.799102735020525f, 0.806952254658248f, 0.81484656918795f, 0.822785751350956f, 0.830769873712124f,
-	0.838799008660978f, 0.846873228412837f, 0.854992605009927f, 0.863157210322481f, 0.871367116049835f,
-	0.879622393721502f, 0.887923114698241f, 0.896269350173118f, 0.904661171172551f, 0.913098648557343f,
-	0.921581853023715f, 0.930110855104312f, 0.938685725169219f, 0.947306533426946f, 0.955973349925421f,
-	0.964686244552961f, 0.973445287039244f, 0.982250546956257f, 0.991102093719252f, 1.0f
+	switch (Channel)
+	{
+		case EChannel::R:
+			return LOCTEXT("RedChannel", "Red Channel");
+		case EChannel::G:
+			return LOCTEXT("GreenChannel", "Green Channel");
+		case EChannel::B:
+			return LOCTEXT("BlueChannel", "Blue Channel");
+		case EChannel::A:
+			return LOCTEXT("AlphaChannel", "Alpha Channel");
+		case EChannel::White:
+			return LOCTEXT("FillWhite", "Fill With White");
+		case EChannel::Black:
+			return LOCTEXT("FillBlack", "Fill With Black");
+	}
+	return LOCTEXT("Error", "Error");
 };
-// clang-format on
 
-uint8 ToGammaSpaceFromLinear(const float In, const bool bSRGB)
+FText FormatToText(EPackFormat Format)
+{
+	switch (Format)
+	{
+		case EPackFormat::Auto:
+			return LOCTEXT("FormatAuto", "Auto");
+		case EPackFormat::BGRA8:
+			return LOCTEXT("FormatBGRA8", "BGRA8");
+		case EPackFormat::G8:
+			return LOCTEXT("FormatG8", "G8");
+		case EPackFormat::G16:
+			return LOCTEXT("FormatG16", "G16");
+		case EPackFormat::RGBA16:
+			return LOCTEXT("FormatRGBA16", "RGBA16");
+		case EPackFormat::RGBA16F:
+			return LOCTEXT("FormatRGBA16F", "RGBA16F (HDR)");
+	}
+	return LOCTEXT("Error", "Error");
+}
+
+/**
+ * @brief Channel option offered in the packer window, built from asset registry data
+ *
+ * Options are immutable and shared by every picker of the window, labels are formatted once. Texture of an option is
+ * loaded asynchronously once the option is selected, options that are never selected are never loaded.
+ */
+struct FChannelOptionItem
 {
-	float Out = FMath::Clamp(In, 0.0f, 1.0f);
+	FChannelOptionItem(const FAssetData& InAsset, const EChannel InChannel)
+		: Asset(InAsset)
+		, Channel(InChannel)
+		, Label(InAsset.IsValid() ? FText::Format(FTextFormat::FromString(TEXT("{0} {1}")),
+												   FText::FromName(InAsset.AssetName),
+												   ChannelToText(InChannel))
+								  : ChannelToText(InChannel))
+		, SearchText(Label.ToString())
+	{
+	}
+
+	/** Source texture, invalid for fill channels */
+	const FAssetData Asset;
+	const EChannel Channel;
+	const FText Label;
+	const FString SearchText;
+
+	bool IsFill() const
+	{
+		return !Asset.IsValid();
+	}
+
+	UTexture* GetTexture() const
+	{
+		return IsFill() ? nullptr : Cast<UTexture>(Asset.FastGetAsset(false));
+	}
+
+	bool IsLoaded() const
+	{
+		return IsFill() || GetTexture() != nullptr;
+	}
 
-	if (bSRGB)
+	/** Start loading the texture, the handle keeps it loaded for as long as the option exists */
+	void RequestLoad() const
 	{
-		Out = Out <= 0.0031308f ? Out * 12.92f : FMath::Pow(Out, 1.0f / 2.4f) * 1.055f - 0.055f;
+		if (!IsLoaded() && !LoadHandle.IsValid())
+		{
+			LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset.ToSoftObjectPath());
+		}
+	}
+
+	/** Whether the texture is sRGB, from its asset registry tag until it is loaded */
+	bool IsSrgb() const
+	{
+		if (const UTexture* Texture = GetTexture())
+		{
+			return Texture->SRGB;
+		}
+		FString Srgb;
+		return !Asset.GetTagValue(TEXT("SRGB"), Srgb) || Srgb.ToBool();
 	}
 
-	return uint8(FMath::FloorToInt(Out * 255.999f));
+	/** Whether every whitespace separated token of the filter is part of the label */
+	bool MatchesFilter(const TArray<FString>& FilterTokens) const
+	{
+		return Algo::AllOf(FilterTokens, [this](const FString& Token) { return SearchText.Contains(Token); });
+	}
+
+private:
+	mutable TSharedPtr<FStreamableHandle> LoadHandle;
+};
+
+using FChannelOptionsItem = TSharedPtr<const FChannelOptionItem>;
+using FChannelOptions = TArray<FChannelOptionsItem>;
+
+/**
+ * @brief Whether the texture has a single source channel, read from its pixel format tag without loading it
+ *
+ * Only textures compressed as grayscale are recognized. Any channel of other single channel sources reads the same
+ * values, so offering them all is harmless.
+ */
+bool IsGrayscaleTextureAsset(const FAssetData& Asset)
+{
+	FString Format;
+	return Asset.GetTagValue(TEXT("Format"), Format)
+		   && (Format == TEXT("G8") || Format == TEXT("G16") || Format == TEXT("PF_G8") || Format == TEXT("PF_G16"));
+}
+
+ETextureSourceFormat GetPackSourceFormat(const EPackFormat Format)
+{
+	switch (Format)
+	{
+		case EPackFormat::G8:
+			return TSF_G8;
+		case EPackFormat::G16:
+			return TSF_G16;
+		case EPackFormat::RGBA16:
+			return TSF_RGBA16;
+		case EPackFormat::RGBA16F:
+			return TSF_RGBA16F;
+		default:
+			return TSF_BGRA8;
+	}
+}
+
+/** Destination of one packed texture with its channel options in BGRA order, only red for single channel formats */
+struct FPackTarget
+{
+	TArray<FChannelOption, TInlineAllocator<4>> Channels;
+	/** Resolved format of the pixels at Dst */
+	EPackFormat Format = EPackFormat::BGRA8;
+	uint8* Dst = nullptr;
+
+	ESampleType GetSampleType() const
+	{
+		return Format == EPackFormat::BGRA8 || Format == EPackFormat::G8 ? ESampleType::U8
+			   : Format == EPackFormat::RGBA16F							 ? ESampleType::F16
+																		 : ESampleType::U16;
+	}
+
+	/** Sample of a packed pixel given channel is written to, 16 bit formats keep red first */
+	int32 GetDstChannelIndex(const int32 ChannelIdx) const
+	{
+		if (Channels.Num() == 1)
+		{
+			return 0;
+		}
+		return Format == EPackFormat::BGRA8 || ChannelIdx == 3 ? ChannelIdx : 2 - ChannelIdx;
+	}
+};
+
+FPackTarget MakePackTarget(const FPackJob& Job, uint8* Dst)
+{
+	const EPackFormat Format = ResolvePackFormat(Job);
+	if (Format == EPackFormat::G8 || Format == EPackFormat::G16)
+	{
+		return {{Job.Red}, Format, Dst};
+	}
+
+	const FChannelOption AlphaOption = Job.Alpha ? Job.Alpha.GetValue() : FChannelOption{nullptr, EChannel::Black};
+	return {{Job.Blue, Job.Green, Job.Red, AlphaOption}, Format, Dst};
 }
 
 /**
- * @brief Resize given image to new size
+ * @brief Describe how given channel option is read from Data and converted to the packed sample
  *
- * Copied from FImageUtils to fix alpha channel not being resized and added option for grayscale images
+ * 16 bit and half outputs are always linear, sRGB sources are converted even when asked to keep sRGB.
+ */
+FChannelSource MakeChannelSource(const FChannelOption& ChannelOption,
+								 const uint8* Data,
+								 const int32 Stride,
+								 const ESampleType SampleType,
+								 const ESampleType DstType)
+{
+	if (ChannelOption.Texture == nullptr)
+	{
+		// Fill channels read the same byte for every pixel
+		static constexpr uint8 Black = 0;
+		static constexpr uint8 White = MAX_uint8;
+		return {ChannelOption.Channel == EChannel::Black ? &Black : &White,
+				0,
+				ESampleType::U8,
+				false,
+				ChannelOption.bInvert};
+	}
+
+	const bool bSRGB = IsSourceChannelSRGB(ChannelOption.Texture, ChannelOption.Channel);
+	const bool bKeepSrgb = ChannelOption.bKeepSrgb && DstType == ESampleType::U8;
+	const bool bTonemap = GetDefault<UTexturePackerSettings>()->HdrMapping == ETexturePackerHdrMapping::Tonemap;
+	return {Data, Stride, SampleType, bSRGB && !bKeepSrgb, ChannelOption.bInvert, bTonemap};
+}
+
+/** Interleave four planes in BGRA order into pixels of given four channel format */
+void InterleavePlanes(const EPackFormat Format, const uint8* Planes, const int64 NumPixels, uint8* Dst)
+{
+	if (Format == EPackFormat::BGRA8)
+	{
+		InterleaveBGRA8(Planes, Planes + NumPixels, Planes + NumPixels * 2, Planes + NumPixels * 3, NumPixels, Dst);
+		return;
+	}
+
+	const uint16* Planes16 = reinterpret_cast<const uint16*>(Planes);
+	InterleaveRGBA16(Planes16 + NumPixels * 2,
+					 Planes16 + NumPixels,
+					 Planes16,
+					 Planes16 + NumPixels * 3,
+					 NumPixels,
+					 reinterpret_cast<uint16*>(Dst));
+}
+
+/**
+ * @brief Pack channels of same sized targets into pixels of their formats with every source decoded up front
  *
- * @tparam ColorType Type stored in pixels. FColor, uint8 or uint16
- * @param SrcWidth X size of the source image
- * @param SrcHeight Y size of the source image
- * @param SrcData Data that will be resized to new size
- * @param DstWidth X size of the destination image
- * @param DstHeight Y size of the destination image
- * @param DstData Resized image data
+ * Sources shared by several targets are decoded once, and every band fills its rows of all targets while the rows of
+ * the decoded planes are still in cache. Single channel targets are converted straight into their pixels.
+ *
+ * @param SourceCache Receives decoded sources, may already hold planes of earlier packs
+ * @param Progress Counts one row of work per decoded channel row and per packed row, stops early when cancelled
+ * @param OutPacked Whether each target was packed, targets with a source that can't be decoded are left incomplete
+ * @return Peak number of bytes held by decoded sources
  */
-template <typename ColorType>
-void ImageResize(const int32 SrcWidth,
-				 const int32 SrcHeight,
-				 const TArrayView<const ColorType> SrcData,
-				 const int32 DstWidth,
-				 const int32 DstHeight,
-				 const TArrayView<ColorType> DstData)
+int64 PackPixelsInMemory(TArrayView<const FPackTarget> Targets,
+						 const int32 SizeX,
+						 const int32 SizeY,
+						 FDecodedSourceCache& SourceCache,
+						 FPackProgress& Progress,
+						 TArrayView<bool> OutPacked)
 {
-	static_assert(TIsSame<ColorType, FColor>::Value || TIsSame<ColorType, uint8>::Value
-					  || TIsSame<ColorType, uint16>::Value,
-				  "Unsupported color type");
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackPixelsInMemory);
 
-	check(SrcData.Num() >= SrcWidth * SrcHeight);
-	check(DstData.Num() >= DstWidth * DstHeight);
+	SourceCache.ResetPeakAllocatedSize();
+	for (const FPackTarget& Target : Targets)
+	{
+		Progress.AddWork(int64(SizeY) * (Target.Channels.Num() + 1));
+	}
 
-	float SrcX = 0;
-	float SrcY = 0;
+	// Every unique source is decoded and resized once, only the channels that are read are kept as compact planes
+	for (const FPackTarget& Target : Targets)
+	{
+		for (const FChannelOption& ChannelOption : Target.Channels)
+		{
+			SourceCache.AddRequest(ChannelOption, SizeX, SizeY);
+		}
+	}
 
-	const float StepSizeX = SrcWidth / static_cast<float>(DstWidth);
-	const float StepSizeY = SrcHeight / static_cast<float>(DstHeight);
+	struct FTargetChannels
+	{
+		FChannelSource Sources[4];
+		FChannelConverter Converters[4];
+	};
+	TArray<FTargetChannels, TInlineAllocator<4>> TargetChannels;
+	TargetChannels.SetNum(Targets.Num());
 
-	for (int32 Y = 0; Y < DstHeight; Y++)
+	int32 MaxSampleSize = 1;
+	for (int32 TargetIdx = 0; TargetIdx < Targets.Num(); ++TargetIdx)
 	{
-		int32 PixelPos = Y * DstWidth;
-		SrcX = 0.0f;
+		const FPackTarget& Target = Targets[TargetIdx];
+		const ESampleType DstType = Target.GetSampleType();
+		MaxSampleSize = FMath::Max(MaxSampleSize, GetSampleSize(DstType));
 
-		for (int32 X = 0; X < DstWidth; X++)
+		for (int32 ChannelIdx = 0; ChannelIdx < Target.Channels.Num(); ++ChannelIdx)
 		{
-			int32 PixelCount = 0;
-			const float EndX = SrcX + StepSizeX;
-			const float EndY = SrcY + StepSizeY;
+			if (Progress.IsCancelled())
+			{
+				return SourceCache.GetPeakAllocatedSize();
+			}
+
+			const FChannelOption& ChannelOption = Target.Channels[ChannelIdx];
+			FChannelSource& Source = TargetChannels[TargetIdx].Sources[ChannelIdx];
+			if (ChannelOption.Texture == nullptr)
+			{
+				Source = MakeChannelSource(ChannelOption, nullptr, 0, ESampleType::U8, DstType);
+			}
+			else
+			{
+				const FSourcePlane* Plane =
+					SourceCache.Get(ChannelOption.Texture, ChannelOption.Channel, SizeX, SizeY);
+				if (Plane == nullptr)
+				{
+					OutPacked[TargetIdx] = false;
+					Progress.CompleteWork(int64(SizeY) * (Target.Channels.Num() - ChannelIdx));
+					break;
+				}
+				Source = MakeChannelSource(
+					ChannelOption, Plane->Bytes.GetData(), Plane->BytesPerChannel, Plane->SampleType, DstType);
+			}
+			TargetChannels[TargetIdx].Converters[ChannelIdx] = SelectChannelConverter(Source, DstType);
+			Progress.CompleteWork(SizeY);
+		}
+	}
 
-			// Generate a rectangular region of pixels and then find the average color of the region.
-			int32 PosY = FMath::TruncToInt(SrcY + 0.5f);
-			PosY = FMath::Clamp<int32>(PosY, 0, (SrcHeight - 1));
+	// Every band resolves its rows of each channel into own planes and interleaves them into each target
+	auto PackRows = [&](const int32 RowStart, const int32 RowEnd)
+	{
+		if (Progress.IsCancelled())
+		{
+			return;
+		}
 
-			int32 PosX = FMath::TruncToInt(SrcX + 0.5f);
-			PosX = FMath::Clamp<int32>(PosX, 0, (SrcWidth - 1));
+		const int64 FirstPixel = int64(RowStart) * SizeX;
+		const int64 NumPixels = int64(RowEnd - RowStart) * SizeX;
 
-			int32 EndPosY = FMath::TruncToInt(EndY + 0.5f);
-			EndPosY = FMath::Clamp<int32>(EndPosY, 0, (SrcHeight - 1));
+		TArray64<uint8> Planes;
+		Planes.SetNumUninitialized(NumPixels * 4 * MaxSampleSize);
+		for (int32 TargetIdx = 0; TargetIdx < Targets.Num(); ++TargetIdx)
+		{
+			if (!OutPacked[TargetIdx])
+			{
+				continue;
+			}
 
-			int32 EndPosX = FMath::TruncToInt(EndX + 0.5f);
-			EndPosX = FMath::Clamp<int32>(EndPosX, 0, (SrcWidth - 1));
+			const FPackTarget& Target = Targets[TargetIdx];
+			const FTargetChannels& Channels = TargetChannels[TargetIdx];
+			uint8* Dst = Target.Dst + FirstPixel * GetPackBytesPerPixel(Target.Format);
 
-			if constexpr (TIsSame<ColorType, FColor>::Value)
+			if (Target.Channels.Num() == 1)
 			{
-				FLinearColor LinearStepColor(0.0f, 0.0f, 0.0f, 0.0f);
-				for (int32 PixelX = PosX; PixelX <= EndPosX; PixelX++)
-				{
-					for (int32 PixelY = PosY; PixelY <= EndPosY; PixelY++)
-					{
-						const int32 StartPixel = PixelX + PixelY * SrcWidth;
+				Channels.Converters[0].Run(
+					Channels.Sources[0].Data + FirstPixel * Channels.Sources[0].Stride, NumPixels, Dst);
+				continue;
+			}
 
-						LinearStepColor += FLinearColor(SrcData[StartPixel]);
-						PixelCount++;
-					}
-				}
-				LinearStepColor /= static_cast<float>(PixelCount);
+			const int64 PlaneBytes = NumPixels * GetSampleSize(Target.GetSampleType());
+			for (int32 ChannelIdx = 0; ChannelIdx < 4; ++ChannelIdx)
+			{
+				const FChannelSource& Source = Channels.Sources[ChannelIdx];
+				Channels.Converters[ChannelIdx].Run(
+					Source.Data + FirstPixel * Source.Stride, NumPixels, Planes.GetData() + ChannelIdx * PlaneBytes);
+			}
+
+			InterleavePlanes(Target.Format, Planes.GetData(), NumPixels, Dst);
+		}
+
+		Progress.CompleteWork(int64(RowEnd - RowStart) * Targets.Num());
+	};
+
+	ParallelForRowBands(SizeY, PackRows);
+
+	return SourceCache.GetPeakAllocatedSize();
+}
+
+/**
+ * @brief Pack channels into pixels of the target format one source at a time, in horizontal tiles
+ *
+ * Only one source mip is locked at once, whole since source data can't be read in parts. Every tile resizes just its
+ * own rows and writes converted channels straight into the destination. Tiles get what the locked mip leaves of
+ * StreamingBudgetMB, a mip that alone exceeds it is warned about and packed in single row tiles.
+ *
+ * @param Progress Counts one row of work per packed channel row, stops early when cancelled
+ * @param OutPeakBytes Peak number of bytes held by the locked source mip and tile buffers
+ * @return False when a source format can't be read or has to be resized but can't be, Target is left incomplete
+ */
+bool PackPixelsStreaming(const FPackTarget& Target,
+						 const int32 SizeX,
+						 const int32 SizeY,
+						 FPackProgress& Progress,
+						 int64& OutPeakBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackPixelsStreaming);
+
+	Progress.AddWork(int64(SizeY) * Target.Channels.Num());
+
+	const ESampleType DstType = Target.GetSampleType();
+	const int32 DstSampleSize = GetSampleSize(DstType);
+	const int32 DstBytesPerPixel = GetPackBytesPerPixel(Target.Format);
+
+	const int64 BudgetBytes = int64(FMath::Max(1, GetDefault<UTexturePackerSettings>()->StreamingBudgetMB)) << 20;
+	OutPeakBytes = 0;
+
+	// Fill channels are grouped under nullptr and processed like a source without data
+	TArray<UTexture*, TInlineAllocator<4>> Textures;
+	for (const FChannelOption& ChannelOption : Target.Channels)
+	{
+		Textures.AddUnique(ChannelOption.Texture);
+	}
+
+	for (UTexture* Texture : Textures)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::StreamSource);
+
+		if (Progress.IsCancelled())
+		{
+			break;
+		}
+
+		ETextureSourceFormat Format = TSF_Invalid;
+		FSourceLayout Layout{1, 1};
+		int32 SrcSizeX = SizeX;
+		int32 SrcSizeY = SizeY;
+		int32 MipIndex = 0;
+		const uint8* SrcBytes = nullptr;
+		int64 SourceBytes = 0;
 
-				// Convert back from linear space to gamma space.
-				const FColor FinalColor = LinearStepColor.ToFColor(true);
+		if (Texture != nullptr)
+		{
+			FTextureSource& Source = Texture->Source;
+			const FSourceMip Mip = SelectSourceMip(Source, SizeX, SizeY);
+			MipIndex = Mip.MipIndex;
+			Format = Source.GetFormat();
+			Layout = GetSourceLayout(Format);
+			if (!Layout.IsValid())
+			{
+				return false;
+			}
+			SrcSizeX = Mip.SizeX;
+			SrcSizeY = Mip.SizeY;
+			SrcBytes = Source.LockMipReadOnly(0, 0, MipIndex);
+			SourceBytes = Source.CalcMipSize(MipIndex);
+		}
+
+		const int32 BytesPerPixel = Layout.NumChannels * Layout.BytesPerChannel;
+		const bool bResize = SrcSizeX != SizeX || SrcSizeY != SizeY;
+		if (bResize && !ensureMsgf(FResampler::CanResize(Format), TEXT("Unsupported resize format")))
+		{
+			Texture->Source.UnlockMip(0, 0, MipIndex);
+			return false;
+		}
 
-				DstData[PixelPos] = FinalColor;
+		// Only the packed channels of this source are resampled, each in its own color space. Shared exponent
+		// mantissas of the same size go through a box filter, which only decodes them
+		TOptional<FResampler> Resamplers[4];
+		int32 ResizedBytesPerChannel = 0;
+		for (int32 ChannelIdx = 0; ChannelIdx < Target.Channels.Num() && SrcBytes != nullptr; ++ChannelIdx)
+		{
+			const FChannelOption& ChannelOption = Target.Channels[ChannelIdx];
+			const int32 SrcChannelIdx = GetSourceChannelIndex(Layout, ChannelOption.Channel);
+			if (ChannelOption.Texture == Texture && (bResize || IsSharedExponentChannel(Layout, SrcChannelIdx)))
+			{
+				const bool bSRGB = IsSourceChannelSRGB(Texture, ChannelOption.Channel);
+				Resamplers[ChannelIdx].Emplace(
+					FResampleFormat::Channel(Format, SrcChannelIdx, bSRGB),
+					SrcSizeX,
+					SrcSizeY,
+					SizeX,
+					SizeY,
+					bResize ? GetDefault<UTexturePackerSettings>()->ResizeFilter : ETexturePackerResizeFilter::Box);
+				ResizedBytesPerChannel =
+					FMath::Max(ResizedBytesPerChannel, GetSampleSize(GetPlaneSampleType(Layout, SrcChannelIdx)));
+			}
+		}
+
+		// Resized rows are compact, otherwise channels are read straight from the source pixels
+		FChannelSource Sources[4];
+		FChannelConverter Converters[4];
+		for (int32 ChannelIdx = 0; ChannelIdx < Target.Channels.Num(); ++ChannelIdx)
+		{
+			const FChannelOption& ChannelOption = Target.Channels[ChannelIdx];
+			if (ChannelOption.Texture == Texture)
+			{
+				const ESampleType SampleType =
+					GetPlaneSampleType(Layout, GetSourceChannelIndex(Layout, ChannelOption.Channel));
+				Sources[ChannelIdx] =
+					MakeChannelSource(ChannelOption,
+									  nullptr,
+									  Resamplers[ChannelIdx].IsSet() ? GetSampleSize(SampleType) : BytesPerPixel,
+									  SampleType,
+									  DstType);
+				Converters[ChannelIdx] = SelectChannelConverter(Sources[ChannelIdx], DstType);
 			}
-			else if constexpr (TIsSame<ColorType, uint8>::Value || TIsSame<ColorType, uint16>::Value)
+		}
+
+		if (SourceBytes >= BudgetBytes)
+		{
+			UE_LOG(LogTexturePacker,
+				   Warning,
+				   TEXT("Source mip of %s takes %.1f MB, over the %.1f MB streaming budget"),
+				   *Texture->GetName(),
+				   SourceBytes / double(1 << 20),
+				   BudgetBytes / double(1 << 20));
+		}
+
+		// Every tile row needs one resized channel row and one converted row, in what the locked mip leaves
+		const int64 TileRowBytes = int64(SizeX) * (ResizedBytesPerChannel + DstSampleSize);
+		const int32 TileRows = int32(FMath::Clamp<int64>((BudgetBytes - SourceBytes) / TileRowBytes, 1, SizeY));
+
+		TArray64<uint8> ResizedTile;
+		TArray64<uint8> PlaneTile;
+		ResizedTile.SetNumUninitialized(int64(TileRows) * SizeX * ResizedBytesPerChannel);
+		PlaneTile.SetNumUninitialized(int64(TileRows) * SizeX * DstSampleSize);
+		OutPeakBytes =
+			FMath::Max(OutPeakBytes, SourceBytes + ResizedTile.GetAllocatedSize() + PlaneTile.GetAllocatedSize());
+
+		for (int32 TileStart = 0; TileStart < SizeY && !Progress.IsCancelled(); TileStart += TileRows)
+		{
+			const int32 TileEnd = FMath::Min(SizeY, TileStart + TileRows);
+
+			// Rows are relative to the tile, resized rows and planes are indexed the same way
+			auto PackTileRows = [&](const int32 RowStart, const int32 RowEnd)
 			{
-				float LinearStepColor = 0.F;
-				for (int32 PixelX = PosX; PixelX <= EndPosX; PixelX++)
+				if (Progress.IsCancelled())
 				{
-					for (int32 PixelY = PosY; PixelY <= EndPosY; PixelY++)
+					return;
+				}
+
+				const int64 TilePixel = int64(RowStart) * SizeX;
+				const int64 FirstPixel = int64(TileStart) * SizeX + TilePixel;
+				const int64 NumPixels = int64(RowEnd - RowStart) * SizeX;
+
+				uint8* ResizedRows = ResizedTile.GetData() + TilePixel * ResizedBytesPerChannel;
+				uint8* PlaneRows = PlaneTile.GetData() + TilePixel * DstSampleSize;
+				uint8* DstRows = Target.Dst + FirstPixel * DstBytesPerPixel;
+
+				for (int32 ChannelIdx = 0; ChannelIdx < Target.Channels.Num(); ++ChannelIdx)
+				{
+					const FChannelOption& ChannelOption = Target.Channels[ChannelIdx];
+					if (ChannelOption.Texture != Texture)
 					{
-						const int32 StartPixel = PixelX + PixelY * SrcWidth;
+						continue;
+					}
 
-						if constexpr (TIsSame<ColorType, uint8>::Value)
+					// Fill channels keep the byte from MakeChannelSource
+					const uint8* ChannelSrc = Sources[ChannelIdx].Data;
+					if (SrcBytes != nullptr)
+					{
+						const int32 ChannelOffset =
+							GetSourceChannelIndex(Layout, ChannelOption.Channel) * Layout.BytesPerChannel;
+						if (Resamplers[ChannelIdx].IsSet())
 						{
-							LinearStepColor += sRGBToLinearTable[SrcData[StartPixel]];
+							Resamplers[ChannelIdx]->ResizeRows(
+								SrcBytes + ChannelOffset, TileStart + RowStart, TileStart + RowEnd, ResizedRows);
+							ChannelSrc = ResizedRows;
 						}
 						else
 						{
-							LinearStepColor += float(SrcData[StartPixel]) / MAX_uint16;
+							ChannelSrc = SrcBytes + FirstPixel * BytesPerPixel + ChannelOffset;
 						}
-						PixelCount++;
 					}
-				}
-				LinearStepColor /= static_cast<float>(PixelCount);
 
-				if constexpr (TIsSame<ColorType, uint8>::Value)
-				{
-					const uint8 FinalColor = ToGammaSpaceFromLinear(LinearStepColor, true);
-					DstData[PixelPos] = FinalColor;
-				}
-				else
-				{
-					const uint16 FinalColor =
-						FMath::RoundToInt(FMath::Clamp(LinearStepColor * MAX_uint16, 0.F, float(MAX_uint16)));
-
-					DstData[PixelPos] = FinalColor;
+					// Single channel formats are converted straight into the packed pixels
+					if (Target.Channels.Num() == 1)
+					{
+						Converters[ChannelIdx].Run(ChannelSrc, NumPixels, DstRows);
+					}
+					else if (DstSampleSize == sizeof(uint8))
+					{
+						Converters[ChannelIdx].Run(ChannelSrc, NumPixels, PlaneRows);
+						ScatterChannel(PlaneRows, NumPixels, DstRows + Target.GetDstChannelIndex(ChannelIdx), 4);
+					}
+					else
+					{
+						Converters[ChannelIdx].Run(ChannelSrc, NumPixels, PlaneRows);
+						ScatterChannel(reinterpret_cast<const uint16*>(PlaneRows),
+									   NumPixels,
+									   reinterpret_cast<uint16*>(DstRows) + Target.GetDstChannelIndex(ChannelIdx),
+									   4);
+					}
+					Progress.CompleteWork(RowEnd - RowStart);
 				}
-			}
-			else
-			{
-				unimplemented();
-			}
+			};
 
-			SrcX = EndX;
-			PixelPos++;
+			ParallelForRowBands(TileEnd - TileStart, PackTileRows);
 		}
 
-		SrcY += StepSizeY;
+		if (Texture != nullptr)
+		{
+			Texture->Source.UnlockMip(0, 0, MipIndex);
+		}
 	}
+
+	return true;
 }
 
-FText ChannelToText(EChannel Channel)
+UTexture* FindSkippedPack(const FPackJob& Job, const FString& Fingerprint, FPackStats* OutStats)
 {
-	switch (Channel)
+	if (Job.bForce)
 	{
-		case EChannel::R:
-			return LOCTEXT("RedChannel", "Red Channel");
-		case EChannel::G:
-			return LOCTEXT("GreenChannel", "Green Channel");
-		case EChannel::B:
-			return LOCTEXT("BlueChannel", "Blue Channel");
-		case EChannel::A:
-			return LOCTEXT("AlphaChannel", "Alpha Channel");
-		case EChannel::White:
-			return LOCTEXT("FillWhite", "Fill With White");
-		case EChannel::Black:
-			return LOCTEXT("FillBlack", "Fill With Black");
+		return nullptr;
 	}
-	return LOCTEXT("Error", "Error");
-};
 
-using FChannelOptionsItem = TSharedPtr<FChannelOption>;
-using FChannelOptions = TArray<FChannelOptionsItem>;
+	UTexture* Existing = FindUpToDatePack(Job, Fingerprint);
+	if (Existing != nullptr)
+	{
+		UE_LOG(LogTexturePacker, Log, TEXT("Skipped %s, sources and options are unchanged"), *Job.GetPackageName());
+		if (OutStats != nullptr)
+		{
+			*OutStats = FPackStats{};
+			OutStats->bSkipped = true;
+		}
+	}
+	return Existing;
+}
 
-UTexture* PackTexture(const TCHAR* PackagePath,
-					  const TCHAR* TextureName,
-					  const int32 InSizeX,
-					  const int32 InSizeY,
-					  const FChannelOption Red,
-					  const FChannelOption Green,
-					  const FChannelOption Blue,
-					  TOptional<FChannelOption> Alpha)
+/**
+ * @brief Fill every mip after mip 0 of a packed mip chain, each box filtered from the previous one
+ *
+ * Packed pixels already carry inverts, only channels the texture samples as sRGB are decoded for filtering.
+ */
+void GeneratePackedMips(const FPackJob& Job, uint8* MipChain)
 {
-	const FString PackageName = FString(PackagePath) / TextureName;
-	UPackage* Package = CreatePackage(*PackageName);
-	Package->FullyLoad();
+	const int32 NumMips = GetPackNumMips(Job);
+	if (NumMips == 1)
+	{
+		return;
+	}
 
-	UTexture2D* Texture = NewObject<UTexture2D>(Package, TextureName, RF_Public | RF_Standalone);
-	Texture->Source.Init(InSizeX, InSizeY, 1, 1, TSF_BGRA8);
-	// Use SRGB only if RGB channels are said to keep SRGB
-	// This is useful when creating pack texture of Diffuse and some other texture
-	Texture->SRGB = Red.bKeepSrgb && Green.bKeepSrgb && Blue.bKeepSrgb;
-	Texture->CompressionSettings = Texture->SRGB ? (Alpha.IsSet() ? TC_BC7 : TC_Default) : TC_Masks;
-	Texture->CompressionNoAlpha = !Alpha.IsSet();
+	TArray<uint8*, TInlineAllocator<16>> Mips;
+	for (int32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+	{
+		Mips.Add(MipChain);
+		MipChain += GetPackedMipBytes(Job, MipIndex);
+	}
 
-	const int32 BytesPerPixel = Texture->Source.GetBytesPerPixel();
+	const EPackFormat Format = ResolvePackFormat(Job);
+	const uint32 RGBMask = Format == EPackFormat::G8 ? 0b1 : 0b111;
+	GenerateMipChain(GetPackSourceFormat(Format), IsPackSRGB(Job) ? RGBMask : 0, Job.SizeX, Job.SizeY, Mips);
+}
 
-	const int32 Size = InSizeX * InSizeY;
+bool PackJobsPixels(TArrayView<const FPackJob> Jobs,
+					TArrayView<uint8* const> Dsts,
+					FDecodedSourceCache* SourceCache,
+					FPackProgress& Progress,
+					TFunctionRef<void(int32 JobIdx, const FPackStats& Stats)> OnPacked)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackJobsPixels);
 
-	struct FChannelOptionBytes
+	check(Jobs.Num() == Dsts.Num());
+
+	const UTexturePackerSettings* Settings = GetDefault<UTexturePackerSettings>();
+	const bool bStreaming = Settings->bStreamingPack;
+
+	auto JoinNames = [&Jobs](const TArray<int32>& JobIndices)
 	{
-		TArray64<uint8> Bytes;
-		int32 BytesPerPixel = 1;
-		int32 ChannelOffset = 0;
-		bool bInvert = false;
-		bool bConvertSRGB = false;
-		bool b16BitChannel = false;
+		return FString::JoinBy(
+			JobIndices, TEXT(", "), [&Jobs](const int32 JobIdx) { return Jobs[JobIdx].GetPackageName(); });
 	};
-	auto ChannelOptionBytes = [Size, InSizeX, InSizeY](FChannelOption ChannelOption) -> FChannelOptionBytes
+
+	// Same sources and options packed before, here or on another machine sharing the cache, give the same pixels
+	TArray<FString> CacheKeys;
+	CacheKeys.SetNum(Jobs.Num());
+	TArray<int32> JobsToPack;
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
 	{
-		TArray64<uint8> Bytes;
-		int32 BytesPerPixel = 1;
-		bool bSRGB = false;
-		bool bSingleChannel = true;
-		bool b16BitChannel = false;
+		const FPackJob& Job = Jobs[JobIdx];
+		const double StartTime = FPlatformTime::Seconds();
+		if (Settings->bUsePackCache)
+		{
+			CacheKeys[JobIdx] = GetPackCacheKey(ComputePackContentHash(Job));
+			if (LoadCachedPixels(CacheKeys[JobIdx], Dsts[JobIdx], GetPackedBytes(Job)))
+			{
+				FPackStats Stats;
+				Stats.PackSeconds = FPlatformTime::Seconds() - StartTime;
+				Stats.bCacheHit = true;
+
+				const FPackCacheStats CacheStats = GetPackCacheStats();
+				UE_LOG(LogTexturePacker,
+					   Log,
+					   TEXT("Fetched pixels of %s (%dx%d) from derived data cache in %.2f ms, %lld hits, %lld misses, "
+							"%.1f MiB saved"),
+					   *Job.GetPackageName(),
+					   Job.SizeX,
+					   Job.SizeY,
+					   Stats.PackSeconds * 1000.0,
+					   CacheStats.Hits,
+					   CacheStats.Misses,
+					   CacheStats.BytesSaved / (1024.0 * 1024.0));
+
+				// Only mip 0 is cached, mips depend on settings that are not part of the content hash
+				GeneratePackedMips(Job, Dsts[JobIdx]);
+				OnPacked(JobIdx, Stats);
+				continue;
+			}
+		}
+		JobsToPack.Add(JobIdx);
+	}
 
-		if (ChannelOption.Texture != nullptr)
+	FDecodedSourceCache LocalSourceCache;
+	FDecodedSourceCache& Cache = SourceCache != nullptr ? *SourceCache : LocalSourceCache;
+	if (!bStreaming)
+	{
+		// Sources read by jobs of different sizes are still decoded once, for all of their sizes
+		for (const int32 JobIdx : JobsToPack)
 		{
-			FTextureSource& Texture = ChannelOption.Texture->Source;
-			bSRGB = ChannelOption.Texture->SRGB && ChannelOption.Channel != EChannel::A;
-			Texture.GetMipData(Bytes, 0);
-			BytesPerPixel = Texture.GetBytesPerPixel();
+			for (const FChannelOption& ChannelOption : MakePackTarget(Jobs[JobIdx], nullptr).Channels)
+			{
+				Cache.AddRequest(ChannelOption, Jobs[JobIdx].SizeX, Jobs[JobIdx].SizeY);
+			}
+		}
+	}
 
-			const ETextureSourceFormat TextureSourceFormat = Texture.GetFormat();
+	// Jobs of the same size are filled in one sweep over the sources, streaming packs one job at a time to stay
+	// within its budget
+	bool bAllPacked = true;
+	while (JobsToPack.Num() > 0)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 SizeX = Jobs[JobsToPack[0]].SizeX;
+		const int32 SizeY = Jobs[JobsToPack[0]].SizeY;
 
-			switch (TextureSourceFormat)
+		TArray<int32> Group;
+		TArray<FPackTarget> Targets;
+		for (int32 PendingIdx = 0; PendingIdx < JobsToPack.Num();)
+		{
+			const int32 JobIdx = JobsToPack[PendingIdx];
+			const bool bSameSize = Jobs[JobIdx].SizeX == SizeX && Jobs[JobIdx].SizeY == SizeY;
+			if (bSameSize && (!bStreaming || Group.Num() == 0))
 			{
-				case TSF_BGRA8:
-					bSingleChannel = false;
-					b16BitChannel = false;
-					break;
-				case TSF_BGRE8:
-					bSingleChannel = false;
-					b16BitChannel = false;
-					break;
-				case TSF_RGBA16:
-					bSingleChannel = false;
-					b16BitChannel = true;
-					break;
-				case TSF_RGBA16F:
-					bSingleChannel = false;
-					b16BitChannel = true;
-					break;
-				case TSF_RGBA8:
-					bSingleChannel = false;
-					b16BitChannel = false;
-					break;
-				case TSF_RGBE8:
-					bSingleChannel = false;
-					b16BitChannel = false;
-					break;
-				case TSF_G8:
-					bSingleChannel = true;
-					b16BitChannel = false;
-					break;
-				case TSF_G16:
-					bSingleChannel = true;
-					b16BitChannel = true;
-					break;
-				default:
-					break;
+				Group.Add(JobIdx);
+				Targets.Add(MakePackTarget(Jobs[JobIdx], Dsts[JobIdx]));
+				JobsToPack.RemoveAt(PendingIdx);
 			}
-
-			if (Texture.GetSizeX() != InSizeX || Texture.GetSizeY() != InSizeY)
+			else
 			{
-				if (TextureSourceFormat == TSF_BGRA8)
-				{
-					TArray64<uint8> ResizedBytes;
-					ResizedBytes.AddUninitialized(Size * BytesPerPixel);
-					ImageResize<FColor>(Texture.GetSizeX(),
-										Texture.GetSizeY(),
-										TArrayView<const FColor>(reinterpret_cast<FColor*>(Bytes.GetData()),
-																 Bytes.Num() / sizeof(FColor)),
-										InSizeX,
-										InSizeY,
-										TArrayView<FColor>(reinterpret_cast<FColor*>(ResizedBytes.GetData()),
-														   ResizedBytes.Num() / sizeof(FColor)));
-					Bytes = MoveTemp(ResizedBytes);
-				}
-				else if (TextureSourceFormat == TSF_G8)
-				{
-					TArray64<uint8> ResizedBytes;
-					ResizedBytes.AddUninitialized(Size * BytesPerPixel);
-					ImageResize<uint8>(Texture.GetSizeX(), Texture.GetSizeY(), Bytes, InSizeX, InSizeY, ResizedBytes);
-					Bytes = MoveTemp(ResizedBytes);
-				}
-				else if (TextureSourceFormat == TSF_G16)
-				{
-					TArray64<uint8> ResizedBytes;
-					ResizedBytes.AddUninitialized(Size * BytesPerPixel);
-					ImageResize<uint16>(Texture.GetSizeX(),
-										Texture.GetSizeY(),
-										TArrayView<const uint16>(reinterpret_cast<uint16*>(Bytes.GetData()),
-																 Bytes.Num() / sizeof(uint16)),
-										InSizeX,
-										InSizeY,
-										TArrayView<uint16>(reinterpret_cast<uint16*>(ResizedBytes.GetData()),
-														   ResizedBytes.Num() / sizeof(uint16)));
-					Bytes = MoveTemp(ResizedBytes);
-				}
-				else
-				{
-					ensureMsgf(false, TEXT("Unsupported resize format"));
-				}
+				++PendingIdx;
 			}
 		}
+
+		TArray<bool> Packed;
+		Packed.Init(true, Targets.Num());
+		int64 PeakBytes = 0;
+		if (!bStreaming)
+		{
+			PeakBytes = PackPixelsInMemory(Targets, SizeX, SizeY, Cache, Progress, Packed);
+		}
 		else
 		{
-			bSingleChannel = true;
+			Packed[0] = PackPixelsStreaming(Targets[0], SizeX, SizeY, Progress, PeakBytes);
+		}
 
-			if (ChannelOption.Channel == EChannel::Black)
+		if (Progress.IsCancelled())
+		{
+			UE_LOG(LogTexturePacker, Log, TEXT("Cancelled packing %s"), *JoinNames(Group));
+			return false;
+		}
+
+		FPackStats Stats;
+		Stats.PackSeconds = FPlatformTime::Seconds() - StartTime;
+		Stats.PeakWorkingSetBytes = PeakBytes;
+
+		UE_LOG(LogTexturePacker,
+			   Log,
+			   TEXT("Packed pixels of %s (%dx%d) in %.2f ms using %d workers, %s peak working set %.1f MiB"),
+			   *JoinNames(Group),
+			   SizeX,
+			   SizeY,
+			   Stats.PackSeconds * 1000.0,
+			   GetNumBandWorkers(SizeY),
+			   bStreaming ? TEXT("streaming") : TEXT("in memory"),
+			   PeakBytes / (1024.0 * 1024.0));
+
+		for (int32 GroupIdx = 0; GroupIdx < Group.Num(); ++GroupIdx)
+		{
+			// Other jobs still get packed, a failed one is never reported through OnPacked
+			const int32 JobIdx = Group[GroupIdx];
+			if (!Packed[GroupIdx])
 			{
-				Bytes.AddZeroed(Size);
+				UE_LOG(LogTexturePacker,
+					   Error,
+					   TEXT("Failed packing %s, a source format can not be read or resized to %dx%d"),
+					   *Jobs[JobIdx].GetPackageName(),
+					   SizeX,
+					   SizeY);
+				bAllPacked = false;
+				continue;
 			}
-			else
+
+			if (Settings->bUsePackCache)
 			{
-				Bytes.AddUninitialized(Size);
-				FMemory::Memset(Bytes.GetData(), MAX_uint8, Size);
+				StoreCachedPixels(CacheKeys[JobIdx], Dsts[JobIdx], GetPackedBytes(Jobs[JobIdx]));
 			}
+			GeneratePackedMips(Jobs[JobIdx], Dsts[JobIdx]);
+			OnPacked(JobIdx, Stats);
 		}
+	}
 
-		const int32 ChannelOffset = bSingleChannel ? 0 : int32(ChannelOption.Channel);
+	return bAllPacked;
+}
 
-		return {MoveTemp(Bytes),
-				BytesPerPixel,
-				ChannelOffset,
-				ChannelOption.bInvert,
-				bSRGB && !ChannelOption.bKeepSrgb,
-				b16BitChannel};
-	};
+bool PackJobPixels(const FPackJob& Job,
+				   uint8* Dst,
+				   FDecodedSourceCache* SourceCache,
+				   FPackProgress& Progress,
+				   FPackStats* OutStats)
+{
+	return PackJobsPixels(MakeArrayView(&Job, 1),
+						  MakeArrayView(&Dst, 1),
+						  SourceCache,
+						  Progress,
+						  [OutStats](int32 /*JobIdx*/, const FPackStats& Stats)
+						  {
+							  if (OutStats != nullptr)
+							  {
+								  *OutStats = Stats;
+							  }
+						  });
+}
+
+UTexture* SavePackedTexture(const FPackJob& Job,
+							const FString& Fingerprint,
+							TFunctionRef<bool(TArrayView<uint8* const> Mips)> WritePixels,
+							FPackStats* OutStats,
+							FPackSaveSession* SaveSession)
+{
+	check(IsInGameThread());
+
+	const FString PackageName = Job.GetPackageName();
+	UPackage* Package = CreatePackage(*PackageName);
+	Package->FullyLoad();
+
+	// Mip chains are only stored for power of two sizes, the texture build can't use others
+	const int32 NumMips = GetPackNumMips(Job);
+	if (GetDefault<UTexturePackerSettings>()->bGenerateMips
+		&& (!FMath::IsPowerOfTwo(Job.SizeX) || !FMath::IsPowerOfTwo(Job.SizeY)))
+	{
+		UE_LOG(LogTexturePacker,
+			   Warning,
+			   TEXT("%s is %dx%d, mips are only generated for power of two sizes"),
+			   *Job.GetPackageName(),
+			   Job.SizeX,
+			   Job.SizeY);
+	}
+
+	const EPackFormat Format = ResolvePackFormat(Job);
+	UTexture2D* Texture = NewObject<UTexture2D>(Package, *Job.TextureName, RF_Public | RF_Standalone);
+	Texture->Source.Init(Job.SizeX, Job.SizeY, 1, NumMips, GetPackSourceFormat(Format));
+	// Use SRGB only if RGB channels are said to keep SRGB
+	// This is useful when creating pack texture of Diffuse and some other texture
+	Texture->SRGB = IsPackSRGB(Job);
+	if (Format == EPackFormat::G8 || Format == EPackFormat::G16)
+	{
+		// Grayscale keeps 16 bit sources at 16 bit on the platform too
+		Texture->CompressionSettings = TC_Grayscale;
+	}
+	else if (Format == EPackFormat::RGBA16F)
+	{
+		Texture->CompressionSettings = TC_HDR;
+	}
+	else
+	{
+		Texture->CompressionSettings = Texture->SRGB ? (Job.Alpha.IsSet() ? TC_BC7 : TC_Default) : TC_Masks;
+	}
+	Texture->CompressionNoAlpha = !Job.Alpha.IsSet();
+	if (NumMips > 1)
+	{
+		Texture->MipGenSettings = TMGS_LeaveExistingMips;
+	}
+	RecordPackJob(Texture, Job, Fingerprint);
+
+	check(Texture->Source.GetBytesPerPixel() == GetPackBytesPerPixel(Format));
+	TArray<uint8*, TInlineAllocator<16>> Mips;
+	for (int32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+	{
+		Mips.Add(Texture->Source.LockMip(MipIndex));
+	}
+	const bool bWritten = WritePixels(Mips);
+	for (int32 MipIndex = NumMips - 1; MipIndex >= 0; --MipIndex)
+	{
+		Texture->Source.UnlockMip(MipIndex);
+	}
+
+	// Cancelled pack leaves the texture unsaved and unreferenced, so it is collected with its package
+	if (!bWritten)
+	{
+		Texture->ClearFlags(RF_Public | RF_Standalone);
+		return nullptr;
+	}
 
-	const FChannelOptionBytes RedBytes = ChannelOptionBytes(Red);
-	const FChannelOptionBytes GreenBytes = ChannelOptionBytes(Green);
-	const FChannelOptionBytes BlueBytes = ChannelOptionBytes(Blue);
-	const FChannelOptionBytes AlphaBytes =
-		ChannelOptionBytes(Alpha ? Alpha.GetValue() : FChannelOption{nullptr, EChannel::Black, false});
+	const double SaveStartTime = FPlatformTime::Seconds();
 
-	uint8* Bytes = Texture->Source.LockMip(0);
+	// Batched textures may be built after their batch is saved, so compression doesn't hold up packing
+	const bool bDeferBuild = SaveSession != nullptr && GetDefault<UTexturePackerSettings>()->bDeferTextureBuild;
+	if (!bDeferBuild)
+	{
+		Texture->UpdateResource();
+	}
 
-	auto GetByte = [](const int32 PixelIdx, const FChannelOptionBytes& Channel) -> uint8
+	ensure(Package->MarkPackageDirty());
+	FAssetRegistryModule::AssetCreated(Texture);
+
+	// Batches save with the session of their caller, a lone texture is saved right away
+	if (SaveSession != nullptr)
 	{
-		if (Channel.b16BitChannel)
+		SaveSession->Add(Package, Texture);
+		if (bDeferBuild)
 		{
-			const uint8 Higher = Channel.Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset];
-			const uint8 Lower = Channel.Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset + 1];
-			const uint16 Value = (Higher << 16) | Lower;
-			return FMath::FloorToInt(float(Value) / float(MAX_uint16) * MAX_uint8);
+			SaveSession->AddDeferredBuild(Texture);
 		}
+	}
+	else
+	{
+		FPackSaveSession LocalSaveSession;
+		LocalSaveSession.Add(Package, Texture);
+		LocalSaveSession.Flush();
+	}
+
+	if (OutStats != nullptr)
+	{
+		OutStats->SaveSeconds = FPlatformTime::Seconds() - SaveStartTime;
+	}
 
-		const uint8 B = Channel.Bytes[PixelIdx * Channel.BytesPerPixel + Channel.ChannelOffset];
-		if (Channel.bConvertSRGB)
+	return Texture;
+}
+
+UTexture* RunPackJob(const FPackJob& Job,
+					 FDecodedSourceCache* SourceCache,
+					 FPackStats* OutStats,
+					 FPackSaveSession* SaveSession)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackTexture);
+
+	const FString Fingerprint = ComputePackFingerprint(Job);
+	if (UTexture* Existing = FindSkippedPack(Job, Fingerprint, OutStats))
+	{
+		return Existing;
+	}
+
+	FPackProgress Progress;
+	return SavePackedTexture(
+		Job,
+		Fingerprint,
+		[&](TArrayView<uint8* const> Mips)
 		{
-			float BLin = sRGBToLinearTable[B];
-			BLin = Channel.bInvert ? 1.f - BLin : BLin;
+			if (Mips.Num() == 1)
+			{
+				return PackJobPixels(Job, Mips[0], SourceCache, Progress, OutStats);
+			}
+
+			// Mips are generated next to mip 0 in one chain and copied over once complete
+			TArray64<uint8> MipChain;
+			MipChain.SetNumUninitialized(GetPackedMipChainBytes(Job));
+			if (!PackJobPixels(Job, MipChain.GetData(), SourceCache, Progress, OutStats))
+			{
+				return false;
+			}
+			CopyPackedMips(Job, MipChain.GetData(), Mips);
+			return true;
+		},
+		OutStats,
+		SaveSession);
+}
 
-			return uint8(FMath::FloorToInt(BLin * 255.999f));
+TArray<UTexture*> RunPackJobs(TArrayView<const FPackJob> Jobs, FDecodedSourceCache* SourceCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackTextures);
+
+	TArray<UTexture*> Textures;
+	Textures.SetNumZeroed(Jobs.Num());
+
+	TArray<FString> Fingerprints;
+	TArray<FPackJob> PendingJobs;
+	TArray<int32> PendingJobIndices;
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		Fingerprints.Add(ComputePackFingerprint(Jobs[JobIdx]));
+		Textures[JobIdx] = FindSkippedPack(Jobs[JobIdx], Fingerprints[JobIdx], nullptr);
+		if (Textures[JobIdx] == nullptr)
+		{
+			PendingJobs.Add(Jobs[JobIdx]);
+			PendingJobIndices.Add(JobIdx);
 		}
-		return Channel.bInvert ? MAX_uint8 - B : B;
-	};
+	}
+
+	// Outputs of one pass are filled together, each is freed as soon as its texture is saved
+	TArray<TArray64<uint8>> Pixels;
+	TArray<uint8*> Dsts;
+	for (const FPackJob& Job : PendingJobs)
+	{
+		Pixels.AddDefaulted_GetRef().SetNumUninitialized(GetPackedMipChainBytes(Job));
+		Dsts.Add(Pixels.Last().GetData());
+	}
+
+	FPackSaveSession SaveSession;
+	FPackProgress Progress;
+	PackJobsPixels(PendingJobs,
+				   Dsts,
+				   SourceCache,
+				   Progress,
+				   [&](const int32 PendingIdx, const FPackStats& /*Stats*/)
+				   {
+					   const int32 JobIdx = PendingJobIndices[PendingIdx];
+					   auto CopyPixels = [&](TArrayView<uint8* const> Mips)
+					   {
+						   CopyPackedMips(Jobs[JobIdx], Pixels[PendingIdx].GetData(), Mips);
+						   return true;
+					   };
+					   Textures[JobIdx] =
+						   SavePackedTexture(Jobs[JobIdx], Fingerprints[JobIdx], CopyPixels, nullptr, &SaveSession);
+					   Pixels[PendingIdx].Empty();
+				   });
+
+	// Outputs that failed to save are reported like outputs that failed to pack
+	const TArray<FString> FailedPackages = SaveSession.Flush();
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		if (FailedPackages.Contains(Jobs[JobIdx].GetPackageName()))
+		{
+			Textures[JobIdx] = nullptr;
+		}
+	}
+
+	return Textures;
+}
+
+UTexture* PackTexture(const TCHAR* PackagePath,
+					  const TCHAR* TextureName,
+					  const int32 InSizeX,
+					  const int32 InSizeY,
+					  const FChannelOption Red,
+					  const FChannelOption Green,
+					  const FChannelOption Blue,
+					  TOptional<FChannelOption> Alpha,
+					  const EPackFormat Format)
+{
+	return RunPackJob({PackagePath, TextureName, InSizeX, InSizeY, Red, Green, Blue, Alpha, Format});
+}
 
-	for (int32 PixelIdx = 0; PixelIdx < Size; ++PixelIdx)
+TArray<UTexture*> PackTextures(const TCHAR* PackagePath, const TArray<FPackOutput>& Outputs)
+{
+	TArray<FPackJob> Jobs;
+	for (const FPackOutput& Output : Outputs)
 	{
-		uint8* Pixel = &Bytes[PixelIdx * BytesPerPixel];
+		Jobs.Add({PackagePath,
+				  Output.TextureName,
+				  Output.SizeX,
+				  Output.SizeY,
+				  Output.Red,
+				  Output.Green,
+				  Output.Blue,
+				  Output.Alpha,
+				  Output.Format});
+	}
+	return RunPackJobs(Jobs);
+}
 
-		Pixel[0] = GetByte(PixelIdx, BlueBytes);
-		Pixel[1] = GetByte(PixelIdx, GreenBytes);
-		Pixel[2] = GetByte(PixelIdx, RedBytes);
-		Pixel[3] = GetByte(PixelIdx, AlphaBytes);
+/**
+ * @brief Searchable picker of a channel option with its invert and keep sRGB flags
+ *
+ * Options are not copied, the drop down lists the shared options or the ones matching the search. Its list view only
+ * generates rows in view, so it stays responsive with thousands of options.
+ */
+class SChannelComboBox final : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SChannelComboBox)
+	{
+	}
+	/** Options shared by all pickers, must outlive the picker */
+	SLATE_ARGUMENT(const FChannelOptions*, OptionsSource)
+	SLATE_ARGUMENT(FChannelOptionsItem, InitialSelection)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		Options = InArgs._OptionsSource;
+		Selected = InArgs._InitialSelection.IsValid() ? InArgs._InitialSelection : (*Options)[0];
+		Selected->RequestLoad();
+
+		// clang-format off
+		ChildSlot
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SAssignNew(ComboButton, SComboButton)
+				.OnGetMenuContent(this, &SChannelComboBox::OnGetMenuContent)
+				.ButtonContent()
+				[
+					SNew(STextBlock).Text(this, &SChannelComboBox::GetCurrentLabel)
+				]
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SSeparator)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(STextBlock).Text(LOCTEXT("Invert", "Invert"))
+				.Visibility(this, &SChannelComboBox::GetInvertCheckBoxVisibility)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SChannelComboBox::GetCurrentInverted)
+				.Visibility(this, &SChannelComboBox::GetInvertCheckBoxVisibility)
+				.OnCheckStateChanged(this, &SChannelComboBox::OnInvertCheckStateChanged)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(STextBlock).Text(LOCTEXT("KeepSrgb", "Keep Srgb"))
+				.Visibility(this, &SChannelComboBox::GetSrgbCheckBoxVisibility)
+			]
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SChannelComboBox::GetCurrentSrgb)
+				.Visibility(this, &SChannelComboBox::GetSrgbCheckBoxVisibility)
+				.OnCheckStateChanged(this, &SChannelComboBox::OnSrgbCheckStateChanged)
+			]
+		];
+		// clang-format on
 	}
 
-	Texture->Source.UnlockMip(0);
-	Texture->UpdateResource();
-
-	ensure(Package->MarkPackageDirty());
-	FAssetRegistryModule::AssetCreated(Texture);
-	const FString PackageFilename =
-		FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-
-	FSavePackageArgs SaveArgs = { nullptr, RF_Public | RF_Standalone, SAVE_None, false,
-			true, true, FDateTime::MinValue(), GError };
-
-	UPackage::SavePackage(Package, Texture, *PackageFilename, SaveArgs);
-	
-	// Add new package to source control
-	if (const ISourceControlModule& SourceControlModule = ISourceControlModule::Get(); SourceControlModule.IsEnabled())
+	FChannelOptionsItem GetSelectedItem() const
 	{
-		ISourceControlProvider& Provider = SourceControlModule.GetProvider();
-		Provider.Execute(ISourceControlOperation::Create<FMarkForAdd>(), Package);
+		return Selected;
 	}
 
-	return Texture;
-}
-
-class SChannelComboBox final : public SCompoundWidget
-{
-public:
-	SLATE_BEGIN_ARGS(SChannelComboBox)
+	/** Selected option with the flags of this picker */
+	FChannelOption GetSelectedOption() const
 	{
+		return {Selected->GetTexture(), Selected->Channel, bInvert, bKeepSrgb};
 	}
-	SLATE_ARGUMENT(FChannelOptions*, OptionsSource)
-	SLATE_ARGUMENT(FChannelOptionsItem, InitialSelection)
-	SLATE_END_ARGS()
 
-	void Construct(const FArguments& InArgs)
+private:
+	TSharedRef<SWidget> OnGetMenuContent()
 	{
-		Options = *InArgs._OptionsSource;
-		Selected = InArgs._InitialSelection.IsValid() ? InArgs._InitialSelection : Options[0];
+		FilterTokens.Reset();
+		FilteredOptions.Reset();
+
+		TSharedRef<SSearchBox> SearchBox = SNew(SSearchBox)
+											   .OnTextChanged(this, &SChannelComboBox::OnFilterTextChanged)
+											   .OnTextCommitted(this, &SChannelComboBox::OnFilterTextCommitted);
 
 		// clang-format off
-		ComboBox = 
-		   SNew(SComboBox<FChannelOptionsItem>)
-			.OptionsSource(&Options)
-			.OnGenerateWidget(this, &SChannelComboBox::OnGenerateWidget)
-			.OnSelectionChanged(this, &SChannelComboBox::OnSelectionChanged)
-			.InitiallySelectedItem(Selected)
+		TSharedRef<SWidget> MenuContent =
+			SNew(SVerticalBox)
+			+SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SHorizontalBox)
-				+SHorizontalBox::Slot()
-				.AutoWidth()
-				[
-					SNew(STextBlock).Text(this, &SChannelComboBox::GetCurrentLabel)
-				]
-				+SHorizontalBox::Slot()
-				.AutoWidth()
-				[
-					SNew(SHorizontalBox)
-					+SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(SSeparator)
-					]
-					+SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(STextBlock).Text(LOCTEXT("Invert", "Invert"))
-						.Visibility(this, &SChannelComboBox::GetInvertCheckBoxVisibility)
-					]
-					+SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(SCheckBox)
-						.IsChecked(this, &SChannelComboBox::GetCurrentInverted)
-						.Visibility(this, &SChannelComboBox::GetInvertCheckBoxVisibility)
-						.OnCheckStateChanged(this, &SChannelComboBox::OnInvertCheckStateChanged)
-					]
-					+SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(STextBlock).Text(LOCTEXT("KeepSrgb", "Keep Srgb"))
-						.Visibility(this, &SChannelComboBox::GetSrgbCheckBoxVisibility)
-					]
-					+SHorizontalBox::Slot()
-					.AutoWidth()
-					[
-						SNew(SCheckBox)
-						.IsChecked(this, &SChannelComboBox::GetCurrentSrgb)
-						.Visibility(this, &SChannelComboBox::GetSrgbCheckBoxVisibility)
-						.OnCheckStateChanged(this, &SChannelComboBox::OnSrgbCheckStateChanged)
-					]
-				]
+				SearchBox
+			]
+			+SVerticalBox::Slot()
+			.MaxHeight(400.f)
+			[
+				SAssignNew(ListView, SListView<FChannelOptionsItem>)
+				.ListItemsSource(Options)
+				.SelectionMode(ESelectionMode::Single)
+				.OnGenerateRow(this, &SChannelComboBox::OnGenerateRow)
+				.OnSelectionChanged(this, &SChannelComboBox::OnListSelectionChanged)
 			];
-
-		ChildSlot
-		[
-			ComboBox.ToSharedRef()
-		];
 		// clang-format on
+
+		ListView->SetSelection(Selected, ESelectInfo::Direct);
+		ListView->RequestScrollIntoView(Selected);
+		ComboButton->SetMenuContentWidgetToFocus(SearchBox);
+
+		return MenuContent;
 	}
 
-	FChannelOptionsItem GetSelectedItem() const
+	TSharedRef<ITableRow> OnGenerateRow(const FChannelOptionsItem Item, const TSharedRef<STableViewBase>& OwnerTable)
 	{
-		return Selected;
+		return SNew(STableRow<FChannelOptionsItem>, OwnerTable)
+			[SNew(STextBlock).Text(Item->Label).HighlightText(this, &SChannelComboBox::GetHighlightText)];
 	}
 
-private:
-	EVisibility GetInvertCheckBoxVisibility() const
+	void OnFilterTextChanged(const FText& Text)
+	{
+		Text.ToString().ParseIntoArrayWS(FilterTokens);
+		HighlightText = FilterTokens.Num() == 1 ? FText::FromString(FilterTokens[0]) : FText::GetEmpty();
+
+		// Without a search the shared options are listed as they are
+		if (FilterTokens.Num() == 0)
+		{
+			FilteredOptions.Reset();
+			ListView->SetItemsSource(Options);
+		}
+		else
+		{
+			FilteredOptions.Reset();
+			for (const FChannelOptionsItem& Item : *Options)
+			{
+				if (Item->MatchesFilter(FilterTokens))
+				{
+					FilteredOptions.Add(Item);
+				}
+			}
+			ListView->SetItemsSource(&FilteredOptions);
+		}
+		ListView->RequestListRefresh();
+	}
+
+	void OnFilterTextCommitted(const FText& /*Text*/, const ETextCommit::Type CommitType)
 	{
-		if (Selected.IsValid() && Selected->Texture != nullptr)
+		// Enter picks the first match
+		const FChannelOptions& Listed = FilterTokens.Num() > 0 ? FilteredOptions : *Options;
+		if (CommitType == ETextCommit::OnEnter && Listed.Num() > 0)
 		{
-			return EVisibility::Visible;
+			Select(Listed[0]);
 		}
-		return EVisibility::Collapsed;
 	}
 
-	EVisibility GetSrgbCheckBoxVisibility() const
+	void OnListSelectionChanged(const FChannelOptionsItem Item, const ESelectInfo::Type SelectInfo)
 	{
-		if (Selected.IsValid() && Selected->Texture != nullptr && Selected->Texture->SRGB)
+		if (Item.IsValid() && SelectInfo != ESelectInfo::OnNavigation && SelectInfo != ESelectInfo::Direct)
 		{
-			return EVisibility::Visible;
+			Select(Item);
 		}
-		return EVisibility::Collapsed;
 	}
 
-	void OnSelectionChanged(FChannelOptionsItem InSelection, ESelectInfo::Type /*SelectInfo*/)
+	void Select(const FChannelOptionsItem& Item)
 	{
-		Selected = InSelection;
+		Selected = Item;
+		Selected->RequestLoad();
+		ComboButton->SetIsOpen(false);
 	}
 
-	void OnInvertCheckStateChanged(const ECheckBoxState CheckState) const
+	FText GetHighlightText() const
 	{
-		Selected->bInvert = CheckState == ECheckBoxState::Checked ? true : false;
+		return HighlightText;
 	}
 
-	void OnSrgbCheckStateChanged(const ECheckBoxState CheckState) const
+	EVisibility GetInvertCheckBoxVisibility() const
 	{
-		Selected->bKeepSrgb = CheckState == ECheckBoxState::Checked ? true : false;
+		return Selected->IsFill() ? EVisibility::Collapsed : EVisibility::Visible;
 	}
 
-	ECheckBoxState GetCurrentInverted() const
+	EVisibility GetSrgbCheckBoxVisibility() const
 	{
-		return Selected->bInvert ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+		return !Selected->IsFill() && Selected->IsSrgb() ? EVisibility::Visible : EVisibility::Collapsed;
 	}
 
-	ECheckBoxState GetCurrentSrgb() const
+	void OnInvertCheckStateChanged(const ECheckBoxState CheckState)
 	{
-		return Selected->bKeepSrgb ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+		bInvert = CheckState == ECheckBoxState::Checked;
 	}
 
-	FText GetCurrentLabel() const
+	void OnSrgbCheckStateChanged(const ECheckBoxState CheckState)
 	{
-		return OptionLabel(Selected, false);
+		bKeepSrgb = CheckState == ECheckBoxState::Checked;
 	}
 
-	FText OptionLabel(FChannelOptionsItem Item, bool bCheckInvertedState = true) const
+	ECheckBoxState GetCurrentInverted() const
 	{
-		if (!Item.IsValid())
-		{
-			return LOCTEXT("SelectOverride", "Select channel override");
-		}
+		return bInvert ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	}
 
-		FText Label = [&]()
-		{
-			if (Item->Texture == nullptr)
-			{
-				return ChannelToText(Item->Channel);
-			}
-			else
-			{
-				return FText::Format(FTextFormat::FromString(TEXT("{0} {1}")),
-									 FText::FromString(Item->Texture->GetName()),
-									 ChannelToText(Item->Channel));
-			}
-		}();
+	ECheckBoxState GetCurrentSrgb() const
+	{
+		return bKeepSrgb ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	}
 
-		if (Item->bInvert && bCheckInvertedState)
+	FText GetCurrentLabel() const
+	{
+		if (!Selected->IsLoaded())
 		{
-			Label = FText::Format(FTextFormat::FromString(TEXT("{0} Inverted")), Label);
+			return FText::Format(LOCTEXT("LoadingOption", "{0} (Loading)"), Selected->Label);
 		}
-
-		return Label;
+		return Selected->Label;
 	}
 
-	TSharedRef<SWidget> OnGenerateWidget(const FChannelOptionsItem Item) const
-	{
-		return SNew(STextBlock).Text(OptionLabel(Item));
-	};
-
+	const FChannelOptions* Options = nullptr;
 	FChannelOptionsItem Selected;
-	FChannelOptions Options;
-	TSharedPtr<SComboBox<FChannelOptionsItem>> ComboBox;
+	bool bInvert = false;
+	bool bKeepSrgb = false;
+
+	/** Menu state, rebuilt every time the drop down opens */
+	FChannelOptions FilteredOptions;
+	TArray<FString> FilterTokens;
+	FText HighlightText;
+	TSharedPtr<SComboButton> ComboButton;
+	TSharedPtr<SListView<FChannelOptionsItem>> ListView;
 };
 
-class STexturePacker final : public SCompoundWidget
+/** Channel selection of one packed texture */
+class SPackOutput final : public SCompoundWidget
 {
 public:
-	SLATE_BEGIN_ARGS(STexturePacker)
+	DECLARE_DELEGATE_OneParam(FOnRemove, const TSharedRef<SPackOutput>&);
+
+	SLATE_BEGIN_ARGS(SPackOutput)
 	{
 	}
+	SLATE_ARGUMENT(const FChannelOptions*, OptionsSource)
+	SLATE_ARGUMENT(FString, NameSuffix)
+	SLATE_ATTRIBUTE(bool, ShowName)
+	/** Output can't be removed when unbound */
+	SLATE_EVENT(FOnRemove, OnRemove)
 	SLATE_END_ARGS()
 
-	FChannelOptions ChannelOptions;
-
-	void Construct(const FArguments& InArgs, TSharedRef<SWindow>& Window, TArray<UTexture2D*> InTextures)
+	void Construct(const FArguments& InArgs)
 	{
-		Textures = MoveTemp(InTextures);
-
-		ChannelOptions.Add(MakeShared<FChannelOption>(nullptr, EChannel::Black));
-		ChannelOptions.Add(MakeShared<FChannelOption>(nullptr, EChannel::White));
-		for (UTexture2D* Texture : Textures)
-		{
-			const ETextureSourceFormat Format = Texture->Source.GetFormat();
-			switch (Format)
-			{
-				case ETextureSourceFormat::TSF_BGRA8:
-				case ETextureSourceFormat::TSF_BGRE8:
-				case ETextureSourceFormat::TSF_RGBA16:
-				case ETextureSourceFormat::TSF_RGBA16F:
-				case ETextureSourceFormat::TSF_RGBA8:
-				case ETextureSourceFormat::TSF_RGBE8:
-				{
-					ChannelOptions.Add(MakeShared<FChannelOption>(Texture, EChannel::R));
-					ChannelOptions.Add(MakeShared<FChannelOption>(Texture, EChannel::G));
-					ChannelOptions.Add(MakeShared<FChannelOption>(Texture, EChannel::B));
-					ChannelOptions.Add(MakeShared<FChannelOption>(Texture, EChannel::A));
-					break;
-				}
-				default:
-					ChannelOptions.Add(MakeShared<FChannelOption>(Texture, EChannel::R));
-			}
-		}
+		const FChannelOptions* ChannelOptions = InArgs._OptionsSource;
 
-		auto UseAlphaCheckbox = SNew(SCheckBox).IsChecked(ECheckBoxState::Unchecked);
-
-		auto RedChannel = SNew(SChannelComboBox).OptionsSource(&ChannelOptions);
-		auto GreenChannel = SNew(SChannelComboBox).OptionsSource(&ChannelOptions);
-		auto BlueChannel = SNew(SChannelComboBox).OptionsSource(&ChannelOptions);
-		auto AlphaChannel =
+		UseAlphaCheckbox = SNew(SCheckBox).IsChecked(ECheckBoxState::Unchecked);
+		RedChannel = SNew(SChannelComboBox).OptionsSource(ChannelOptions);
+		GreenChannel = SNew(SChannelComboBox).OptionsSource(ChannelOptions);
+		BlueChannel = SNew(SChannelComboBox).OptionsSource(ChannelOptions);
+		AlphaChannel =
 			SNew(SChannelComboBox)
-				.OptionsSource(&ChannelOptions)
-				.InitialSelection(ChannelOptions[1])
+				.OptionsSource(ChannelOptions)
+				.InitialSelection((*ChannelOptions)[1])
 				.Visibility_Lambda(
-					[UseAlphaCheckbox]()
-					{ return UseAlphaCheckbox->IsChecked() ? EVisibility::Visible : EVisibility::Collapsed; });
+					[this]() { return UseAlphaCheckbox->IsChecked() ? EVisibility::Visible : EVisibility::Collapsed; });
+		NameSuffix = SNew(SEditableTextBox).Text(FText::FromString(InArgs._NameSuffix));
+
+		const TAttribute<bool> ShowName = InArgs._ShowName;
+		const FOnRemove OnRemove = InArgs._OnRemove;
 
 		// clang-format off
 		ChildSlot
@@ -694,6 +1360,35 @@ public:
 			SNew(SVerticalBox)
 			+SVerticalBox::Slot()
 			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				.Visibility_Lambda([ShowName](){
+					return ShowName.Get(false) ? EVisibility::Visible : EVisibility::Collapsed;
+				})
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock).Text(LOCTEXT("NameSuffix", "Name Suffix"))
+				]
+				+SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				[
+					NameSuffix.ToSharedRef()
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(LOCTEXT("RemoveOutput", "Remove"))
+					.Visibility(OnRemove.IsBound() ? EVisibility::Visible : EVisibility::Collapsed)
+					.OnClicked_Lambda([this, OnRemove](){
+						OnRemove.ExecuteIfBound(SharedThis(this));
+						return FReply::Handled();
+					})
+				]
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
 			[
 				SNew(SHorizontalBox)
 				+SHorizontalBox::Slot()
@@ -704,35 +1399,198 @@ public:
 				+SHorizontalBox::Slot()
 				.AutoWidth()
 				[
-					UseAlphaCheckbox
+					UseAlphaCheckbox.ToSharedRef()
 				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SSeparator)
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(STextBlock).Text(LOCTEXT("Format", "Format"))
+				]
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SComboButton)
+					.ToolTipText(LOCTEXT("FormatTooltip",
+						"Auto packs single channels as G8 or G16 and keeps 16 bit and HDR sources at their precision"))
+					.OnGetMenuContent(this, &SPackOutput::OnGetFormatMenuContent)
+					.ButtonContent()
+					[
+						SNew(STextBlock).Text_Lambda([this](){ return FormatToText(Format); })
+					]
+				]
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				RedChannel.ToSharedRef()
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				GreenChannel.ToSharedRef()
+			]
+			+SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				BlueChannel.ToSharedRef()
 			]
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
-				RedChannel
+				AlphaChannel.ToSharedRef()
 			]
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
-				GreenChannel
+				SNew(SSeparator)
 			]
+		];
+		// clang-format on
+	}
+
+	/** Whether textures of all selected channels finished loading */
+	bool IsLoaded() const
+	{
+		return RedChannel->GetSelectedItem()->IsLoaded() && GreenChannel->GetSelectedItem()->IsLoaded()
+			   && BlueChannel->GetSelectedItem()->IsLoaded()
+			   && (!UseAlphaCheckbox->IsChecked() || AlphaChannel->GetSelectedItem()->IsLoaded());
+	}
+
+	/** Job packing the selected channels at the size of the smallest selected source, nothing when none is selected */
+	TOptional<FPackJob> MakeJob(const FString& PackagePath, const FString& BaseName) const
+	{
+		const bool bUseAlpha = UseAlphaCheckbox->IsChecked();
+
+		int32 MinX = MAX_int32;
+		int32 MinY = MAX_int32;
+
+		auto FindMin = [&MinX, &MinY](const TSharedPtr<SChannelComboBox>& Combo) {
+			if (UTexture* Texture = Combo->GetSelectedItem()->GetTexture())
+			{
+				MinX = FMath::Min(MinX, Texture->Source.GetSizeX());
+				MinY = FMath::Min(MinY, Texture->Source.GetSizeY());
+			}
+		};
+
+		FindMin(RedChannel);
+		FindMin(GreenChannel);
+		FindMin(BlueChannel);
+		if (bUseAlpha)
+		{
+			FindMin(AlphaChannel);
+		}
+
+		if (MinX == MAX_int32 || MinY == MAX_int32)
+		{
+			return {};
+		}
+
+		return FPackJob{PackagePath,
+						BaseName + NameSuffix->GetText().ToString(),
+						MinX,
+						MinY,
+						RedChannel->GetSelectedOption(),
+						GreenChannel->GetSelectedOption(),
+						BlueChannel->GetSelectedOption(),
+						bUseAlpha ? TOptional<FChannelOption>(AlphaChannel->GetSelectedOption())
+								  : TOptional<FChannelOption>(),
+						Format};
+	}
+
+private:
+	TSharedRef<SWidget> OnGetFormatMenuContent()
+	{
+		FMenuBuilder MenuBuilder(true, nullptr);
+		for (int32 FormatIdx = 0; FormatIdx <= int32(EPackFormat::RGBA16F); ++FormatIdx)
+		{
+			const EPackFormat Option = EPackFormat(FormatIdx);
+			MenuBuilder.AddMenuEntry(FormatToText(Option),
+									 FText::GetEmpty(),
+									 FSlateIcon(),
+									 FUIAction(FExecuteAction::CreateLambda([this, Option]() { Format = Option; })));
+		}
+		return MenuBuilder.MakeWidget();
+	}
+
+	TSharedPtr<SCheckBox> UseAlphaCheckbox;
+	TSharedPtr<SChannelComboBox> RedChannel;
+	TSharedPtr<SChannelComboBox> GreenChannel;
+	TSharedPtr<SChannelComboBox> BlueChannel;
+	TSharedPtr<SChannelComboBox> AlphaChannel;
+	TSharedPtr<SEditableTextBox> NameSuffix;
+	EPackFormat Format = EPackFormat::BGRA8;
+};
+
+class STexturePacker final : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STexturePacker)
+	{
+	}
+	SLATE_END_ARGS()
+
+	FChannelOptions ChannelOptions;
+
+	void Construct(const FArguments& InArgs, TSharedRef<SWindow>& Window, TArray<FAssetData> InTextureAssets)
+	{
+		TextureAssets = MoveTemp(InTextureAssets);
+
+		// Options come from asset registry data alone, textures load only once their option is selected
+		ChannelOptions.Add(MakeShared<FChannelOptionItem>(FAssetData(), EChannel::Black));
+		ChannelOptions.Add(MakeShared<FChannelOptionItem>(FAssetData(), EChannel::White));
+		for (const FAssetData& TextureAsset : TextureAssets)
+		{
+			if (IsGrayscaleTextureAsset(TextureAsset))
+			{
+				ChannelOptions.Add(MakeShared<FChannelOptionItem>(TextureAsset, EChannel::R));
+			}
+			else
+			{
+				ChannelOptions.Add(MakeShared<FChannelOptionItem>(TextureAsset, EChannel::R));
+				ChannelOptions.Add(MakeShared<FChannelOptionItem>(TextureAsset, EChannel::G));
+				ChannelOptions.Add(MakeShared<FChannelOptionItem>(TextureAsset, EChannel::B));
+				ChannelOptions.Add(MakeShared<FChannelOptionItem>(TextureAsset, EChannel::A));
+			}
+		}
+
+		OutputsBox = SNew(SVerticalBox);
+		AddOutput();
+
+		// clang-format off
+		ChildSlot
+		[
+			SNew(SVerticalBox)
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
-				BlueChannel
+				OutputsBox.ToSharedRef()
 			]
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
-				AlphaChannel
+				SNew(SButton)
+				.Text(LOCTEXT("AddOutput", "Add Output"))
+				.ToolTipText(LOCTEXT("AddOutputTooltip", "Pack another texture from the same sources in the same pass"))
+				.OnClicked_Lambda([this](){
+					AddOutput();
+					return FReply::Handled();
+				})
 			]
 			+SVerticalBox::Slot()
 			.AutoHeight()
 			[
 				SNew(SButton)
 				.Text(LOCTEXT("Pack", "Pack"))
-				.OnClicked_Lambda([this, RedChannel, GreenChannel, BlueChannel, AlphaChannel, Window, UseAlphaCheckbox](){
+				.IsEnabled_Lambda([this](){
+					// Selected textures may still be loading
+					return Algo::AllOf(Outputs, [](const TSharedRef<SPackOutput>& Item){ return Item->IsLoaded(); });
+				})
+				.OnClicked_Lambda([this, Window](){
 					const FString Path = 
 						FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser")
 							.Get().CreateModalSaveAssetDialog({});	
@@ -742,45 +1600,23 @@ public:
 
 					PathPart += TEXT("/");
 
-					int32 MinX = MAX_int32;
-					int32 MinY = MAX_int32;
-
-					auto FindMin = [&MinX, &MinY](const TSharedRef<SChannelComboBox>& Combo) {
-						if (UTexture* Texture = Combo->GetSelectedItem().Get()->Texture)
-						{
-							MinX = FMath::Min(MinX, Texture->Source.GetSizeX());
-							MinY = FMath::Min(MinY, Texture->Source.GetSizeY());
-						}
-					};
-
-					FindMin(RedChannel);
-					FindMin(GreenChannel);
-					FindMin(BlueChannel);
-					if (UseAlphaCheckbox->IsChecked())
-					{
-						FindMin(AlphaChannel);
-					}
-
-					if (!ensure(MinX != MAX_int32 && MinY != MAX_int32))
+					if (FilenamePart.IsEmpty())
 					{
 						return FReply::Handled();
 					}
 
-					if (FilenamePart.IsEmpty())
+					TArray<FPackJob> Jobs;
+					for (const TSharedRef<SPackOutput>& Output : Outputs)
 					{
-						return FReply::Handled();
+						TOptional<FPackJob> Job = Output->MakeJob(PathPart, FilenamePart);
+						if (!ensure(Job.IsSet()))
+						{
+							return FReply::Handled();
+						}
+						Jobs.Add(MoveTemp(Job.GetValue()));
 					}
 
-					PackTexture(*PathPart,
-								*FilenamePart,
-								MinX,
-								MinY,
-								*RedChannel->GetSelectedItem().Get(),
-								*GreenChannel->GetSelectedItem().Get(),
-								*BlueChannel->GetSelectedItem().Get(),
-								UseAlphaCheckbox->IsChecked()
-									? TOptional<FChannelOption>(*AlphaChannel->GetSelectedItem().Get())
-									: TOptional<FChannelOption>());
+					ShowPackNotification(FPackTask::Launch(MoveTemp(Jobs)));
 					Window->RequestDestroyWindow();
 					return FReply::Handled();
 				})
@@ -790,7 +1626,88 @@ public:
 	}
 
 private:
-	TArray<UTexture2D*> Textures;
+	/** Progress of a background pack with a button to cancel it, kept until the pack completes */
+	static void ShowPackNotification(const TSharedRef<FPackTask>& Task)
+	{
+		const TWeakPtr<FPackTask> WeakTask = Task;
+
+		FNotificationInfo Info(FText::GetEmpty());
+		Info.Text = TAttribute<FText>::CreateLambda(
+			[WeakTask]()
+			{
+				const TSharedPtr<FPackTask> PinnedTask = WeakTask.Pin();
+				return FText::Format(LOCTEXT("PackProgress", "Packing textures {0}"),
+									 FText::AsPercent(PinnedTask.IsValid() ? PinnedTask->GetProgress() : 1.f));
+			});
+		Info.bFireAndForget = false;
+
+		const FSimpleDelegate OnCancel = FSimpleDelegate::CreateLambda(
+			[WeakTask]()
+			{
+				if (const TSharedPtr<FPackTask> PinnedTask = WeakTask.Pin())
+				{
+					PinnedTask->Cancel();
+				}
+			});
+		Info.ButtonDetails.Emplace(LOCTEXT("CancelPack", "Cancel"),
+								   FText::GetEmpty(),
+								   OnCancel,
+								   SNotificationItem::CS_Pending);
+
+		const TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (!Notification.IsValid())
+		{
+			return;
+		}
+		Notification->SetCompletionState(SNotificationItem::CS_Pending);
+
+		Task->SetOnComplete(
+			[Notification, WeakTask](const TArray<UTexture*>& Packed)
+			{
+				const TSharedPtr<FPackTask> PinnedTask = WeakTask.Pin();
+				const bool bCancelled = PinnedTask.IsValid() && PinnedTask->IsCancelled();
+				const bool bSucceeded = !bCancelled && !Packed.Contains(nullptr);
+				Notification->SetText(bCancelled    ? LOCTEXT("PackCancelled", "Packing cancelled")
+									  : bSucceeded ? LOCTEXT("PackSucceeded", "Packing finished")
+												   : LOCTEXT("PackFailed", "Packing failed, see the output log"));
+				Notification->SetCompletionState(bSucceeded ? SNotificationItem::CS_Success
+															: SNotificationItem::CS_Fail);
+				Notification->ExpireAndFadeout();
+			});
+	}
+
+	/** Add channel selection of another packed texture, every output after the first is named with its own suffix */
+	void AddOutput()
+	{
+		const bool bFirst = Outputs.Num() == 0;
+		const SPackOutput::FOnRemove OnRemove =
+			bFirst ? SPackOutput::FOnRemove() : SPackOutput::FOnRemove::CreateSP(this, &STexturePacker::RemoveOutput);
+		TSharedPtr<SPackOutput> Output;
+
+		// clang-format off
+		OutputsBox->AddSlot()
+		.AutoHeight()
+		[
+			SAssignNew(Output, SPackOutput)
+			.OptionsSource(&ChannelOptions)
+			.NameSuffix(bFirst ? FString() : FString::Printf(TEXT("_%d"), Outputs.Num() + 1))
+			.ShowName_Lambda([this]() { return Outputs.Num() > 1; })
+			.OnRemove(OnRemove)
+		];
+		// clang-format on
+
+		Outputs.Add(Output.ToSharedRef());
+	}
+
+	void RemoveOutput(const TSharedRef<SPackOutput>& Output)
+	{
+		OutputsBox->RemoveSlot(Output);
+		Outputs.Remove(Output);
+	}
+
+	TArray<FAssetData> TextureAssets;
+	TSharedPtr<SVerticalBox> OutputsBox;
+	TArray<TSharedRef<SPackOutput>> Outputs;
 };
 
 class FTexturePackerModule final : public IModuleInterface
@@ -805,6 +1722,16 @@ class FTexturePackerModule final : public IModuleInterface
 
 		MenuExtenders.Add(
 			FContentBrowserMenuExtender_SelectedAssets::CreateStatic(&ContentBrowserMenuExtender_SelectedAssets));
+
+		if (!IsRunningCommandlet())
+		{
+			AutoRepacker = MakeUnique<FAutoRepacker>();
+		}
+	}
+
+	virtual void ShutdownModule() override
+	{
+		AutoRepacker.Reset();
 	}
 
 	static TSharedRef<FExtender> ContentBrowserMenuExtender_SelectedAssets(const TArray<FAssetData>& SelectedAssets)
@@ -843,19 +1770,20 @@ class FTexturePackerModule final : public IModuleInterface
 		TSharedRef<SWindow> PackerWindow =
 			SNew(SWindow).Title(LOCTEXT("PackerWindow", "Texture Packer")).SizingRule(ESizingRule::Autosized);
 
-		TArray<UTexture2D*> Textures;
-		Algo::TransformIf(
-			SelectedAssets,
-			Textures,
-			[](const FAssetData& AssetData) { return AssetData.AssetClass == UTexture2D::StaticClass()->GetFName(); },
-			[](const FAssetData& AssetData) { return Cast<UTexture2D>(AssetData.GetAsset()); });
+		// Nothing is loaded here, the window opens at once no matter how many textures are selected
+		TArray<FAssetData> TextureAssets;
+		Algo::CopyIf(SelectedAssets,
+					 TextureAssets,
+					 [](const FAssetData& AssetData)
+					 { return AssetData.AssetClass == UTexture2D::StaticClass()->GetFName(); });
 
-		PackerWindow->SetContent(SNew(STexturePacker, PackerWindow, MoveTemp(Textures)));
+		PackerWindow->SetContent(SNew(STexturePacker, PackerWindow, MoveTemp(TextureAssets)));
 
 		FSlateApplication::Get().AddWindow(PackerWindow);
 	};
 
 	FContentBrowserMenuExtender_SelectedAssets MenuExtenderHandle;
+	TUniquePtr<FAutoRepacker> AutoRepacker;
 };
 
 }  // namespace TexturePacker
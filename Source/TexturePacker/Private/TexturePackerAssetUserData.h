@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "Engine/Texture.h"
+#include "TexturePacker.h"
+
+#include "TexturePackerAssetUserData.generated.h"
+
+/** One packed channel as it was requested */
+USTRUCT()
+struct FTexturePackerChannelRecord
+{
+	GENERATED_BODY()
+
+	/** Source texture, null for fill channels */
+	UPROPERTY()
+	TSoftObjectPtr<UTexture> Texture;
+
+	/** TexturePacker::EChannel read from the source */
+	UPROPERTY()
+	uint8 Channel = 0;
+
+	UPROPERTY()
+	bool bInvert = false;
+
+	UPROPERTY()
+	bool bKeepSrgb = false;
+};
+
+/** Saved with every packed texture, records what it was packed from */
+UCLASS()
+class UTexturePackerAssetUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	/** Hash of sources, channel options, size and packer version of the last pack */
+	UPROPERTY()
+	FString Fingerprint;
+
+	/**
+	 * TexturePacker::EPackFormat that was asked for, Auto is resolved again on every repack. Records saved before
+	 * formats existed load the default and keep packing BGRA8
+	 */
+	UPROPERTY()
+	uint8 Format = uint8(TexturePacker::EPackFormat::BGRA8);
+
+	/** Packed channels in RGBA order, alpha only when it was packed */
+	UPROPERTY()
+	TArray<FTexturePackerChannelRecord> Channels;
+
+	virtual bool IsEditorOnly() const override
+	{
+		return true;
+	}
+
+	/** Record of given texture, null when it was not created by the packer */
+	static const UTexturePackerAssetUserData* Find(const UTexture* Texture)
+	{
+		if (const TArray<UAssetUserData*>* UserDataArray = Texture->GetAssetUserDataArray())
+		{
+			for (const UAssetUserData* UserData : *UserDataArray)
+			{
+				if (const UTexturePackerAssetUserData* Record = Cast<UTexturePackerAssetUserData>(UserData))
+				{
+					return Record;
+				}
+			}
+		}
+		return nullptr;
+	}
+};
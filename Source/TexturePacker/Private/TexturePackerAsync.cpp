@@ -0,0 +1,267 @@
+#include "TexturePackerAsync.h"
+
+#include "Async/Async.h"
+#include "Editor.h"
+#include "Engine/Texture.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystems/ImportSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerAsync, Log, All);
+
+namespace TexturePacker
+{
+FPackTask::FPackTask(TArray<FPackJob> InJobs) : Jobs(MoveTemp(InJobs))
+{
+	Fingerprints.SetNum(Jobs.Num());
+	Skipped.SetNumZeroed(Jobs.Num());
+	Textures.SetNumZeroed(Jobs.Num());
+}
+
+FPackTask::~FPackTask()
+{
+	UnregisterSourceHooks();
+}
+
+TSharedRef<FPackTask> FPackTask::Launch(TArray<FPackJob> InJobs)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FPackTask> Task = MakeShareable(new FPackTask(MoveTemp(InJobs)));
+
+	// Up to date outputs are found on the game thread, they may have to be loaded
+	for (int32 JobIdx = 0; JobIdx < Task->Jobs.Num(); ++JobIdx)
+	{
+		Task->Fingerprints[JobIdx] = ComputePackFingerprint(Task->Jobs[JobIdx]);
+		Task->Textures[JobIdx] = FindSkippedPack(Task->Jobs[JobIdx], Task->Fingerprints[JobIdx], nullptr);
+		Task->Skipped[JobIdx] = Task->Textures[JobIdx] != nullptr;
+		if (Task->Skipped[JobIdx])
+		{
+			Task->Progress.AddWork(1);
+			Task->Progress.CompleteWork(1);
+		}
+	}
+
+	// Sources are read on the worker, any change to them has to wait until it stopped
+	Task->PreChangeHandle =
+		FCoreUObjectDelegates::OnPreObjectPropertyChanged.AddSP(Task, &FPackTask::OnPreObjectPropertyChanged);
+	if (GEditor != nullptr)
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			Task->PreImportHandle = ImportSubsystem->OnAssetPreImport.AddSP(Task, &FPackTask::OnAssetPreImport);
+		}
+	}
+
+	Task->Worker = Async(EAsyncExecution::ThreadPool,
+						 [WorkerTask = TSharedPtr<FPackTask>(Task)]() mutable
+						 {
+							 const int32 NumPosted = WorkerTask->PackAll();
+
+							 // The last reference must be released on the game thread where FGCObject is unregistered
+							 AsyncTask(ENamedThreads::GameThread,
+									   [CompletedTask = MoveTemp(WorkerTask), NumPosted]()
+									   {
+										   CompletedTask->NumPosted = NumPosted;
+										   CompletedTask->TryComplete();
+									   });
+						 });
+
+	return Task;
+}
+
+float FPackTask::GetProgress() const
+{
+	return Jobs.Num() > 0 ? Progress.GetFraction() : 1.f;
+}
+
+void FPackTask::Cancel()
+{
+	Progress.Cancel();
+}
+
+void FPackTask::CancelAndWait()
+{
+	check(IsInGameThread());
+
+	Cancel();
+	WaitForWorker();
+
+	// Jobs the worker finished and its completion are posted to the game thread, run them before returning
+	if (!bDone)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+	ensureMsgf(bDone, TEXT("Pack task did not complete after its worker stopped"));
+}
+
+bool FPackTask::ReadsSource(const UObject* Object) const
+{
+	if (Object == nullptr)
+	{
+		return false;
+	}
+
+	for (const FPackJob& Job : Jobs)
+	{
+		for (const FChannelOption* ChannelOption : Job.GetChannelOptions())
+		{
+			if (ChannelOption->Texture == Object)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FPackTask::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FPackJob& Job : Jobs)
+	{
+		Collector.AddReferencedObject(Job.Red.Texture);
+		Collector.AddReferencedObject(Job.Green.Texture);
+		Collector.AddReferencedObject(Job.Blue.Texture);
+		if (Job.Alpha.IsSet())
+		{
+			Collector.AddReferencedObject(Job.Alpha->Texture);
+		}
+	}
+	Collector.AddReferencedObjects(Textures);
+}
+
+int32 FPackTask::PackAll()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::PackTask);
+
+	TArray<FPackJob> PendingJobs;
+	TArray<int32> PendingJobIndices;
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		if (!Skipped[JobIdx])
+		{
+			PendingJobs.Add(Jobs[JobIdx]);
+			PendingJobIndices.Add(JobIdx);
+		}
+	}
+
+	TArray<TArray64<uint8>> Pixels;
+	TArray<uint8*> Dsts;
+	for (const FPackJob& Job : PendingJobs)
+	{
+		Pixels.AddDefaulted_GetRef().SetNumUninitialized(GetPackedMipChainBytes(Job));
+		Dsts.Add(Pixels.Last().GetData());
+	}
+
+	// Pixels move to the game thread as soon as their job is packed, the worker goes on with the remaining jobs
+	int32 Posted = 0;
+	PackJobsPixels(PendingJobs,
+				   Dsts,
+				   nullptr,
+				   Progress,
+				   [&](const int32 PendingIdx, const FPackStats& /*Stats*/)
+				   {
+					   ++Posted;
+					   AsyncTask(ENamedThreads::GameThread,
+								 [Task = AsShared(),
+								  JobIdx = PendingJobIndices[PendingIdx],
+								  JobPixels = MoveTemp(Pixels[PendingIdx])]() mutable
+								 { Task->FinishJob(JobIdx, MoveTemp(JobPixels)); });
+				   });
+
+	return Posted;
+}
+
+void FPackTask::FinishJob(const int32 JobIdx, TArray64<uint8> Pixels)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::FinishPackJob);
+
+	auto CopyPixels = [this, JobIdx, &Pixels](TArrayView<uint8* const> Mips)
+	{
+		CopyPackedMips(Jobs[JobIdx], Pixels.GetData(), Mips);
+		return true;
+	};
+	Textures[JobIdx] = SavePackedTexture(Jobs[JobIdx], Fingerprints[JobIdx], CopyPixels, nullptr, &SaveSession);
+
+	++NumFinished;
+	TryComplete();
+}
+
+void FPackTask::TryComplete()
+{
+	if (bDone || NumFinished != NumPosted)
+	{
+		return;
+	}
+
+	for (const FString& FailedPackage : SaveSession.Flush())
+	{
+		for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+		{
+			if (Jobs[JobIdx].GetPackageName() == FailedPackage)
+			{
+				Textures[JobIdx] = nullptr;
+			}
+		}
+	}
+
+	bDone = true;
+	UnregisterSourceHooks();
+	if (OnComplete)
+	{
+		OnComplete(Textures);
+	}
+}
+
+void FPackTask::OnPreObjectPropertyChanged(UObject* Object, const FEditPropertyChain& /*PropertyChain*/)
+{
+	CancelForSourceChange(Object);
+}
+
+void FPackTask::OnAssetPreImport(UFactory* /*Factory*/,
+								 UClass* /*Class*/,
+								 UObject* Parent,
+								 const FName& Name,
+								 const TCHAR* /*Type*/)
+{
+	// Reimports replace the source of the existing asset, new imports don't touch any source
+	CancelForSourceChange(StaticFindObjectFast(UObject::StaticClass(), Parent, Name));
+}
+
+void FPackTask::CancelForSourceChange(const UObject* Object)
+{
+	if (bDone || Worker.IsReady() || !ReadsSource(Object))
+	{
+		return;
+	}
+
+	UE_LOG(LogTexturePackerAsync, Log, TEXT("Cancelled packing, source %s is about to change"), *Object->GetPathName());
+	Cancel();
+	WaitForWorker();
+}
+
+void FPackTask::WaitForWorker()
+{
+	check(IsInGameThread());
+
+	if (Worker.IsValid())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::WaitForPackWorker);
+		Worker.Wait();
+	}
+}
+
+void FPackTask::UnregisterSourceHooks()
+{
+	FCoreUObjectDelegates::OnPreObjectPropertyChanged.Remove(PreChangeHandle);
+	PreChangeHandle.Reset();
+
+	if (GEditor != nullptr && PreImportHandle.IsValid())
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ImportSubsystem->OnAssetPreImport.Remove(PreImportHandle);
+		}
+	}
+	PreImportHandle.Reset();
+}
+}  // namespace TexturePacker
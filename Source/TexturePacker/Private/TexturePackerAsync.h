@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TexturePackerJob.h"
+#include "TexturePackerSave.h"
+#include "UObject/GCObject.h"
+
+class FEditPropertyChain;
+class UFactory;
+
+namespace TexturePacker
+{
+/**
+ * @brief Packs running in the background
+ *
+ * Pixels of all jobs are packed on a worker thread in one pass, so sources shared by several jobs are decoded once.
+ * Every finished job is created on the game thread while the worker packs the remaining ones, and all of them are
+ * saved together with one round of source control requests once the last one is created.
+ * Sources are kept alive until the task completes. An edit or reimport of a source cancels the task and waits for the
+ * worker before the source changes, so it is never read while it changes.
+ */
+class FPackTask final : public FGCObject, public TSharedFromThis<FPackTask>
+{
+public:
+	/** Output of every job in job order, null for cancelled jobs */
+	using FOnComplete = TFunction<void(const TArray<UTexture*>& Textures)>;
+
+	/** Start packing in the background, game thread only */
+	static TSharedRef<FPackTask> Launch(TArray<FPackJob> InJobs);
+
+	virtual ~FPackTask() override;
+
+	/** Called on the game thread once every job finished or was cancelled. Set right after Launch */
+	void SetOnComplete(FOnComplete InOnComplete)
+	{
+		OnComplete = MoveTemp(InOnComplete);
+	}
+
+	/** Completed part of all jobs */
+	float GetProgress() const;
+
+	/** Stop at the next band, jobs that already finished stay saved */
+	void Cancel();
+
+	/** Cancel and block until the worker stopped and every job it finished is saved, game thread only */
+	void CancelAndWait();
+
+	/** Whether given object is a source of one of the jobs */
+	bool ReadsSource(const UObject* Object) const;
+
+	bool IsCancelled() const
+	{
+		return Progress.IsCancelled();
+	}
+
+	/** Whether every job was saved or cancelled and OnComplete was called */
+	bool IsDone() const
+	{
+		return bDone;
+	}
+
+	int32 Num() const
+	{
+		return Jobs.Num();
+	}
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("TexturePacker::FPackTask");
+	}
+
+private:
+	explicit FPackTask(TArray<FPackJob> InJobs);
+
+	/** Worker thread, packs pixels of every job that was not skipped. Returns number of jobs posted for saving */
+	int32 PackAll();
+
+	/** Game thread, creates texture of one packed job and queues it for saving */
+	void FinishJob(const int32 JobIdx, TArray64<uint8> Pixels);
+
+	/** Game thread, saves all textures and completes the task once the worker is done and every job is created */
+	void TryComplete();
+
+	void OnPreObjectPropertyChanged(UObject* Object, const FEditPropertyChain& PropertyChain);
+
+	void OnAssetPreImport(UFactory* Factory, UClass* Class, UObject* Parent, const FName& Name, const TCHAR* Type);
+
+	/** Cancel and wait for the worker when a source is about to change */
+	void CancelForSourceChange(const UObject* Object);
+
+	/** Block until the worker returned, game thread only */
+	void WaitForWorker();
+
+	void UnregisterSourceHooks();
+
+	TArray<FPackJob> Jobs;
+	TArray<FString> Fingerprints;
+	TArray<bool> Skipped;
+	FPackProgress Progress;
+	FOnComplete OnComplete;
+	TFuture<void> Worker;
+	FDelegateHandle PreChangeHandle;
+	FDelegateHandle PreImportHandle;
+
+	/** Game thread state */
+	FPackSaveSession SaveSession;
+	TArray<UTexture*> Textures;
+	int32 NumPosted = INDEX_NONE;
+	int32 NumFinished = 0;
+	bool bDone = false;
+};
+}  // namespace TexturePacker
@@ -0,0 +1,301 @@
+#include "TexturePackerAutoRepack.h"
+
+#include "Algo/AllOf.h"
+#include "Algo/Count.h"
+#include "AssetRegistryModule.h"
+#include "Editor.h"
+#include "Engine/Texture.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "TexturePackerAssetUserData.h"
+#include "TexturePackerAsync.h"
+#include "TexturePackerJob.h"
+#include "TexturePackerSettings.h"
+#include "UObject/UObjectHash.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerAutoRepack, Log, All);
+
+namespace TexturePacker
+{
+TArray<FSoftObjectPath> FPackDependencyIndex::FindPacks(const UTexture* Source)
+{
+	const FSoftObjectPath SourcePath(Source);
+	Resolve(SourcePath);
+
+	const TSet<FSoftObjectPath>* Packs = PacksOfSource.Find(SourcePath);
+	return Packs != nullptr ? Packs->Array() : TArray<FSoftObjectPath>();
+}
+
+void FPackDependencyIndex::UpdatePack(const UTexture* Packed)
+{
+	const FSoftObjectPath PackedPath(Packed);
+	for (TPair<FSoftObjectPath, TSet<FSoftObjectPath>>& Packs : PacksOfSource)
+	{
+		Packs.Value.Remove(PackedPath);
+	}
+
+	if (const UTexturePackerAssetUserData* Record = UTexturePackerAssetUserData::Find(Packed))
+	{
+		for (const FTexturePackerChannelRecord& Channel : Record->Channels)
+		{
+			if (!Channel.Texture.IsNull())
+			{
+				PacksOfSource.FindOrAdd(Channel.Texture.ToSoftObjectPath()).Add(PackedPath);
+			}
+		}
+	}
+}
+
+void FPackDependencyIndex::Resolve(const FSoftObjectPath& SourcePath)
+{
+	bool bAlreadyResolved = false;
+	ResolvedSources.Add(SourcePath, &bAlreadyResolved);
+	if (bAlreadyResolved)
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(FName(*SourcePath.GetLongPackageName()),
+								 Referencers,
+								 UE::AssetRegistry::EDependencyCategory::Package,
+								 UE::AssetRegistry::EDependencyQuery::Soft);
+
+	// Only textures among the referencers are loaded, and only to read their records
+	for (const FName Referencer : Referencers)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(Referencer, Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			const UClass* AssetClass = Asset.GetClass();
+			if (AssetClass != nullptr && AssetClass->IsChildOf<UTexture>())
+			{
+				if (const UTexture* Packed = Cast<UTexture>(Asset.GetAsset()))
+				{
+					UpdatePack(Packed);
+				}
+			}
+		}
+	}
+}
+
+FAutoRepacker::FAutoRepacker()
+{
+	PropertyChangedHandle =
+		FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FAutoRepacker::OnObjectPropertyChanged);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FAutoRepacker::OnPackageSaved);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAutoRepacker::Tick), 0.25f);
+
+	// Import subsystem exists only once the editor engine is up
+	if (GEditor != nullptr)
+	{
+		RegisterReimport();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FAutoRepacker::RegisterReimport);
+	}
+}
+
+FAutoRepacker::~FAutoRepacker()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	// The worker and the game thread work it posted must not outlive the module
+	if (ActiveTask.IsValid())
+	{
+		ActiveTask->SetOnComplete(nullptr);
+		ActiveTask->CancelAndWait();
+		ActiveTask.Reset();
+	}
+
+	if (GEditor != nullptr && ReimportHandle.IsValid())
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+		}
+	}
+}
+
+void FAutoRepacker::RegisterReimport()
+{
+	if (GEditor != nullptr)
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FAutoRepacker::OnAssetReimport);
+		}
+	}
+}
+
+void FAutoRepacker::OnAssetReimport(UObject* Object)
+{
+	if (const UTexture* Texture = Cast<UTexture>(Object))
+	{
+		QueueSource(Texture, false);
+	}
+}
+
+void FAutoRepacker::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// Dragging a slider sends interactive changes, the final value arrives as a regular change
+	if (Event.ChangeType == EPropertyChangeType::Interactive)
+	{
+		return;
+	}
+
+	if (const UTexture* Texture = Cast<UTexture>(Object))
+	{
+		QueueSource(Texture, false);
+	}
+}
+
+void FAutoRepacker::OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context)
+{
+	ForEachObjectWithPackage(
+		Package,
+		[this](UObject* Object)
+		{
+			if (const UTexture* Texture = Cast<UTexture>(Object))
+			{
+				Index.UpdatePack(Texture);
+			}
+			return true;
+		},
+		false);
+}
+
+void FAutoRepacker::QueueSource(const UTexture* Source, const bool bFromRepack)
+{
+	if (!GetDefault<UTexturePackerSettings>()->bAutoRepack)
+	{
+		return;
+	}
+
+	if (!bFromRepack)
+	{
+		WavePacks.Reset();
+
+		// The running repack read the old source, it stops and all of its packs are repacked once it completes
+		if (ActiveTask.IsValid() && ActiveTask->ReadsSource(Source))
+		{
+			ActiveTask->Cancel();
+			PendingPacks.Append(RepackingPacks);
+			LastChangeTime = FPlatformTime::Seconds();
+		}
+	}
+
+	for (const FSoftObjectPath& Pack : Index.FindPacks(Source))
+	{
+		if (!bFromRepack || !WavePacks.Contains(Pack))
+		{
+			PendingPacks.Add(Pack);
+			LastChangeTime = FPlatformTime::Seconds();
+		}
+	}
+}
+
+bool FAutoRepacker::Tick(float /*DeltaTime*/)
+{
+	const double Delay = GetDefault<UTexturePackerSettings>()->AutoRepackDelaySeconds;
+	if (PendingPacks.Num() > 0 && !ActiveTask.IsValid() && FPlatformTime::Seconds() - LastChangeTime >= Delay)
+	{
+		RepackPending();
+	}
+	return true;
+}
+
+void FAutoRepacker::RepackPending()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::AutoRepack);
+
+	TSet<FSoftObjectPath> Packs = MoveTemp(PendingPacks);
+	PendingPacks.Reset();
+
+	TArray<FPackJob> Jobs;
+	TArray<FSoftObjectPath> JobPaths;
+	for (const FSoftObjectPath& PackedPath : Packs)
+	{
+		if (TOptional<FPackJob> Job = GetRecordedPackJob(Cast<UTexture>(PackedPath.TryLoad())))
+		{
+			Jobs.Add(MoveTemp(Job.GetValue()));
+			JobPaths.Add(PackedPath);
+		}
+		else
+		{
+			UE_LOG(LogTexturePackerAutoRepack,
+				   Warning,
+				   TEXT("Can't repack %s, it or one of its sources no longer exists"),
+				   *PackedPath.ToString());
+		}
+	}
+
+	// A pack reading another pending pack waits for its new output, unless every one of them does, which only happens
+	// when packs read each other
+	const TSet<FSoftObjectPath> JobPathSet(JobPaths);
+	auto ReadsPendingPack = [&JobPathSet](const FPackJob& Job)
+	{
+		for (const FChannelOption* ChannelOption : Job.GetChannelOptions())
+		{
+			if (ChannelOption->Texture != nullptr && JobPathSet.Contains(FSoftObjectPath(ChannelOption->Texture)))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+	if (!Algo::AllOf(Jobs, ReadsPendingPack))
+	{
+		for (int32 JobIdx = Jobs.Num() - 1; JobIdx >= 0; --JobIdx)
+		{
+			if (ReadsPendingPack(Jobs[JobIdx]))
+			{
+				PendingPacks.Add(JobPaths[JobIdx]);
+				Jobs.RemoveAt(JobIdx);
+				JobPaths.RemoveAt(JobIdx);
+			}
+		}
+	}
+
+	if (Jobs.Num() == 0)
+	{
+		return;
+	}
+
+	RepackingPacks.Append(JobPaths);
+	WavePacks.Append(JobPaths);
+
+	// Packs that share a reimported source decode it once
+	ActiveTask = FPackTask::Launch(MoveTemp(Jobs));
+	ActiveTask->SetOnComplete(
+		[this, NumChanged = JobPaths.Num()](const TArray<UTexture*>& Repacked)
+		{
+			UE_LOG(LogTexturePackerAutoRepack,
+				   Log,
+				   TEXT("Sources of %d packed textures changed, %d repacked"),
+				   NumChanged,
+				   Repacked.Num() - Algo::Count(Repacked, nullptr));
+
+			RepackingPacks.Reset();
+			ActiveTask.Reset();
+
+			// Repacked textures are sources of other packs as well
+			for (const UTexture* Texture : Repacked)
+			{
+				if (Texture != nullptr)
+				{
+					QueueSource(Texture, true);
+				}
+			}
+		});
+}
+}  // namespace TexturePacker
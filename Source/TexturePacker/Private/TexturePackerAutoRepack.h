@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "CoreMinimal.h"
+#include "UObject/ObjectSaveContext.h"
+
+class UTexture;
+
+namespace TexturePacker
+{
+class FPackTask;
+
+/**
+ * @brief Reverse index from source textures to the packed textures that read them
+ *
+ * Packed textures keep soft references to their sources in UTexturePackerAssetUserData, so the asset registry knows
+ * every referencer of a source. A source is resolved through the registry the first time it is queried, packed
+ * textures saved afterwards keep their entries current.
+ */
+class FPackDependencyIndex
+{
+public:
+	/** Packed textures that read given source */
+	TArray<FSoftObjectPath> FindPacks(const UTexture* Source);
+
+	/** Replace entries of a packed texture with its current sources */
+	void UpdatePack(const UTexture* Packed);
+
+private:
+	void Resolve(const FSoftObjectPath& SourcePath);
+
+	TMap<FSoftObjectPath, TSet<FSoftObjectPath>> PacksOfSource;
+	TSet<FSoftObjectPath> ResolvedSources;
+};
+
+/**
+ * @brief Repacks packed textures when one of their sources is reimported or edited
+ *
+ * Changes are coalesced. Every change restarts AutoRepackDelaySeconds and once sources stay unchanged that long, each
+ * affected packed texture is repacked once, no matter how many of its sources changed how many times. Repacks run in
+ * the background, changes made meanwhile are repacked after the running one completes. A change to a source of the
+ * running repack cancels it, and its packs are repacked again once it stops. Repacked textures that other packs read
+ * queue those packs too.
+ */
+class FAutoRepacker
+{
+public:
+	FAutoRepacker();
+	~FAutoRepacker();
+
+	FAutoRepacker(const FAutoRepacker&) = delete;
+	FAutoRepacker& operator=(const FAutoRepacker&) = delete;
+
+private:
+	void RegisterReimport();
+
+	void OnAssetReimport(UObject* Object);
+
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+	void OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context);
+
+	/** @param bFromRepack Source is an output of the repack that just completed, not a change from outside */
+	void QueueSource(const UTexture* Source, const bool bFromRepack);
+
+	bool Tick(float DeltaTime);
+
+	void RepackPending();
+
+	FPackDependencyIndex Index;
+	TSet<FSoftObjectPath> PendingPacks;
+	double LastChangeTime = 0.0;
+	/** Repack running in the background, the next one starts once it completes */
+	TSharedPtr<FPackTask> ActiveTask;
+	/** Outputs of the running repack, queued again when one of its sources changes before it completes */
+	TSet<FSoftObjectPath> RepackingPacks;
+	/** Packs repacked since the last change from outside, repacked outputs don't queue them again so cycles end */
+	TSet<FSoftObjectPath> WavePacks;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle ReimportHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
+}  // namespace TexturePacker
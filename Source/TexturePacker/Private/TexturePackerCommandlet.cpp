@@ -0,0 +1,687 @@
+#include "TexturePackerCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/Texture.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "TextureCompiler.h"
+#include "TexturePackerDerivedData.h"
+#include "TexturePackerJob.h"
+#include "TexturePackerSettings.h"
+#include "TexturePackerSave.h"
+#include "TexturePackerSourceCache.h"
+#include "UObject/GCObject.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerCommandlet, Log, All);
+
+namespace TexturePacker
+{
+namespace
+{
+/** Job read from the manifest, jobs that failed to load keep the reason in Error and are reported, not packed */
+struct FManifestJob
+{
+	FPackJob Job;
+	FString Error;
+};
+
+bool ParseChannel(const FString& Name, EChannel& OutChannel)
+{
+	static const TPair<const TCHAR*, EChannel> Channels[] = {
+		{TEXT("R"), EChannel::R},
+		{TEXT("G"), EChannel::G},
+		{TEXT("B"), EChannel::B},
+		{TEXT("A"), EChannel::A},
+		{TEXT("White"), EChannel::White},
+		{TEXT("Black"), EChannel::Black},
+	};
+
+	for (const TPair<const TCHAR*, EChannel>& Channel : Channels)
+	{
+		if (Name.Equals(Channel.Key, ESearchCase::IgnoreCase))
+		{
+			OutChannel = Channel.Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TPair<const TCHAR*, EPackFormat> PackFormats[] = {
+	{TEXT("Auto"), EPackFormat::Auto},
+	{TEXT("BGRA8"), EPackFormat::BGRA8},
+	{TEXT("G8"), EPackFormat::G8},
+	{TEXT("G16"), EPackFormat::G16},
+	{TEXT("RGBA16"), EPackFormat::RGBA16},
+	{TEXT("RGBA16F"), EPackFormat::RGBA16F},
+};
+
+bool ParseFormat(const FString& Name, EPackFormat& OutFormat)
+{
+	for (const TPair<const TCHAR*, EPackFormat>& Format : PackFormats)
+	{
+		if (Name.Equals(Format.Key, ESearchCase::IgnoreCase))
+		{
+			OutFormat = Format.Value;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* GetFormatName(const EPackFormat Format)
+{
+	for (const TPair<const TCHAR*, EPackFormat>& Entry : PackFormats)
+	{
+		if (Entry.Value == Format)
+		{
+			return Entry.Key;
+		}
+	}
+	return TEXT("Unknown");
+}
+
+bool ParseChannelOption(const FJsonObject& Object, FChannelOption& OutOption, FString& OutError)
+{
+	FString ChannelName;
+	if (!Object.TryGetStringField(TEXT("Channel"), ChannelName) || !ParseChannel(ChannelName, OutOption.Channel))
+	{
+		OutError = FString::Printf(TEXT("Invalid channel '%s'"), *ChannelName);
+		return false;
+	}
+
+	OutOption.Texture = nullptr;
+	if (OutOption.Channel != EChannel::White && OutOption.Channel != EChannel::Black)
+	{
+		FString TexturePath;
+		Object.TryGetStringField(TEXT("Texture"), TexturePath);
+		OutOption.Texture = LoadObject<UTexture>(nullptr, *TexturePath);
+		if (OutOption.Texture == nullptr)
+		{
+			OutError = FString::Printf(TEXT("Failed to load source texture '%s'"), *TexturePath);
+			return false;
+		}
+	}
+
+	Object.TryGetBoolField(TEXT("Invert"), OutOption.bInvert);
+	Object.TryGetBoolField(TEXT("KeepSrgb"), OutOption.bKeepSrgb);
+	return true;
+}
+
+bool ParseJob(const FJsonObject& Object, FPackJob& OutJob, FString& OutError)
+{
+	if (!Object.TryGetStringField(TEXT("PackagePath"), OutJob.PackagePath)
+		|| !Object.TryGetStringField(TEXT("TextureName"), OutJob.TextureName))
+	{
+		OutError = TEXT("Missing PackagePath or TextureName");
+		return false;
+	}
+
+	FText Reason;
+	if (!FPackageName::IsValidLongPackageName(OutJob.GetPackageName(), false, &Reason))
+	{
+		OutError = Reason.ToString();
+		return false;
+	}
+
+	const TPair<const TCHAR*, FChannelOption*> Channels[] = {
+		{TEXT("Red"), &OutJob.Red},
+		{TEXT("Green"), &OutJob.Green},
+		{TEXT("Blue"), &OutJob.Blue},
+	};
+
+	for (const TPair<const TCHAR*, FChannelOption*>& Channel : Channels)
+	{
+		const TSharedPtr<FJsonObject>* ChannelObject = nullptr;
+		if (!Object.TryGetObjectField(Channel.Key, ChannelObject))
+		{
+			OutError = FString::Printf(TEXT("Missing %s channel"), Channel.Key);
+			return false;
+		}
+		if (!ParseChannelOption(**ChannelObject, *Channel.Value, OutError))
+		{
+			return false;
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* AlphaObject = nullptr;
+	if (Object.TryGetObjectField(TEXT("Alpha"), AlphaObject))
+	{
+		FChannelOption Alpha{nullptr, EChannel::Black};
+		if (!ParseChannelOption(**AlphaObject, Alpha, OutError))
+		{
+			return false;
+		}
+		OutJob.Alpha = Alpha;
+	}
+
+	FString FormatName;
+	if (Object.TryGetStringField(TEXT("Format"), FormatName) && !ParseFormat(FormatName, OutJob.Format))
+	{
+		OutError = FString::Printf(TEXT("Invalid format '%s'"), *FormatName);
+		return false;
+	}
+
+	// Same default as the packer window, smallest size of the packed sources
+	if (!Object.TryGetNumberField(TEXT("SizeX"), OutJob.SizeX)
+		|| !Object.TryGetNumberField(TEXT("SizeY"), OutJob.SizeY))
+	{
+		OutJob.SizeX = MAX_int32;
+		OutJob.SizeY = MAX_int32;
+		for (const FChannelOption* ChannelOption : OutJob.GetChannelOptions())
+		{
+			if (ChannelOption->Texture != nullptr)
+			{
+				OutJob.SizeX = FMath::Min(OutJob.SizeX, ChannelOption->Texture->Source.GetSizeX());
+				OutJob.SizeY = FMath::Min(OutJob.SizeY, ChannelOption->Texture->Source.GetSizeY());
+			}
+		}
+	}
+
+	if (OutJob.SizeX <= 0 || OutJob.SizeY <= 0 || OutJob.SizeX == MAX_int32 || OutJob.SizeY == MAX_int32)
+	{
+		OutError = TEXT("Invalid size, set SizeX and SizeY when no channel reads a texture");
+		return false;
+	}
+
+	return true;
+}
+
+/** Part of the manifest packed by one commandlet run */
+struct FShard
+{
+	int32 Index = 0;
+	int32 Num = 1;
+
+	/**
+	 * Jobs are assigned by a hash of the lowercase output package name, which gives the same split on every machine
+	 * no matter the order of jobs in the manifest
+	 */
+	bool Contains(const FString& PackageName) const
+	{
+		const FTCHARToUTF8 Utf8(*PackageName.ToLower());
+		return FCrc::MemCrc32(Utf8.Get(), Utf8.Length()) % uint32(Num) == uint32(Index);
+	}
+};
+
+/** Manifest identity written to every report, so merge can tell that all shards packed the same manifest */
+struct FManifestInfo
+{
+	uint32 Crc = 0;
+	int32 NumJobs = 0;
+};
+
+bool LoadManifest(const FString& Filename,
+				  const FShard& Shard,
+				  TArray<FManifestJob>& OutJobs,
+				  FManifestInfo& OutInfo,
+				  FString& OutError)
+{
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *Filename))
+	{
+		OutError = FString::Printf(TEXT("Failed to read manifest %s"), *Filename);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TArray<TSharedPtr<FJsonValue>>* JobValues = nullptr;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid()
+		|| !Root->TryGetArrayField(TEXT("Jobs"), JobValues))
+	{
+		OutError = FString::Printf(TEXT("Manifest %s is not an object with a Jobs array"), *Filename);
+		return false;
+	}
+
+	OutInfo.Crc = FCrc::StrCrc32(*Json);
+	OutInfo.NumJobs = JobValues->Num();
+
+	for (const TSharedPtr<FJsonValue>& JobValue : *JobValues)
+	{
+		const TSharedPtr<FJsonObject>* JobObject = nullptr;
+		if (!JobValue->TryGetObject(JobObject))
+		{
+			// Invalid jobs have no package name, the first shard reports them
+			if (Shard.Index == 0)
+			{
+				OutJobs.AddDefaulted_GetRef().Error = TEXT("Job is not an object");
+			}
+			continue;
+		}
+
+		// Package name is checked before parsing, so sources of other shards are never loaded
+		FString PackagePath;
+		FString TextureName;
+		(*JobObject)->TryGetStringField(TEXT("PackagePath"), PackagePath);
+		(*JobObject)->TryGetStringField(TEXT("TextureName"), TextureName);
+		if (!Shard.Contains(PackagePath / TextureName))
+		{
+			continue;
+		}
+
+		FManifestJob& ManifestJob = OutJobs.AddDefaulted_GetRef();
+		ParseJob(**JobObject, ManifestJob.Job, ManifestJob.Error);
+	}
+
+	return true;
+}
+
+FString GetShardReportFilename(const FString& ReportDir, const FShard& Shard)
+{
+	return ReportDir / FString::Printf(TEXT("PackReport_%d_of_%d.json"), Shard.Index, Shard.Num);
+}
+
+bool SaveReport(const TSharedRef<FJsonObject>& Report, const FString& Filename)
+{
+	FString ReportJson;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportJson));
+	if (!FFileHelper::SaveStringToFile(ReportJson, *Filename))
+	{
+		UE_LOG(LogTexturePackerCommandlet, Error, TEXT("Failed to write report %s"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+double ToMiB(const uint64 Bytes)
+{
+	return Bytes / (1024.0 * 1024.0);
+}
+
+/** Keeps sources of jobs that are not packed yet alive while garbage is collected between save batches */
+class FManifestSources final : public FGCObject
+{
+public:
+	TArray<UTexture*> Textures;
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		Collector.AddReferencedObjects(Textures);
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("TexturePacker::FManifestSources");
+	}
+};
+}  // namespace
+}  // namespace TexturePacker
+
+UTexturePackerCommandlet::UTexturePackerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UTexturePackerCommandlet::Main(const FString& Params)
+{
+	return FParse::Param(*Params, TEXT("Merge")) ? MergeShardReports(Params) : PackManifest(Params);
+}
+
+int32 UTexturePackerCommandlet::PackManifest(const FString& Params)
+{
+	using namespace TexturePacker;
+
+	FString ManifestFilename;
+	FShard Shard;
+	FParse::Value(*Params, TEXT("Shard="), Shard.Index);
+	FParse::Value(*Params, TEXT("NumShards="), Shard.Num);
+	if (!FParse::Value(*Params, TEXT("Manifest="), ManifestFilename) || Shard.Num < 1 || Shard.Index < 0
+		|| Shard.Index >= Shard.Num)
+	{
+		UE_LOG(LogTexturePackerCommandlet,
+			   Error,
+			   TEXT("Usage: -run=TexturePacker -Manifest=packs.json [-Shard=N -NumShards=M] [-Report=report.json] "
+					"[-ReportDir=Dir] [-MaxWorkers=N] [-Force] [-SaveBatch=N] [-FakeSourceControl]"));
+		return 1;
+	}
+
+	FString ReportDir = FPaths::ProjectSavedDir() / TEXT("TexturePacker");
+	FParse::Value(*Params, TEXT("ReportDir="), ReportDir);
+	FString ReportFilename =
+		Shard.Num > 1 ? GetShardReportFilename(ReportDir, Shard) : ReportDir / TEXT("PackReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportFilename);
+
+	int32 MaxWorkers = 0;
+	if (FParse::Value(*Params, TEXT("MaxWorkers="), MaxWorkers))
+	{
+		GetMutableDefault<UTexturePackerSettings>()->MaxWorkerThreads = FMath::Max(0, MaxWorkers);
+	}
+
+	const bool bForce = FParse::Param(*Params, TEXT("Force"));
+
+	int32 SaveBatchSize = 64;
+	FParse::Value(*Params, TEXT("SaveBatch="), SaveBatchSize);
+	SaveBatchSize = FMath::Max(1, SaveBatchSize);
+
+	// Fake provider records source control requests locally, for runs without a server
+	TUniquePtr<FFakePackSourceControl> FakeSourceControl;
+	if (FParse::Param(*Params, TEXT("FakeSourceControl")))
+	{
+		FakeSourceControl = MakeUnique<FFakePackSourceControl>();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FManifestJob> Jobs;
+	FManifestInfo ManifestInfo;
+	FString Error;
+	if (!LoadManifest(ManifestFilename, Shard, Jobs, ManifestInfo, Error))
+	{
+		UE_LOG(LogTexturePackerCommandlet, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+	// One cache for the whole run, so a texture read by several jobs is decoded once. Its planes are released after
+	// the last job that reads it, which keeps memory bounded by the textures still in use
+	FDecodedSourceCache SourceCache;
+	TMap<const UTexture*, int32> LastJobOfTexture;
+	FManifestSources ManifestSources;
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		if (!Jobs[JobIdx].Error.IsEmpty())
+		{
+			continue;
+		}
+		Jobs[JobIdx].Job.bForce = bForce;
+		for (const FChannelOption* ChannelOption : Jobs[JobIdx].Job.GetChannelOptions())
+		{
+			SourceCache.AddRequest(*ChannelOption, Jobs[JobIdx].Job.SizeX, Jobs[JobIdx].Job.SizeY);
+			if (ChannelOption->Texture != nullptr)
+			{
+				LastJobOfTexture.Add(ChannelOption->Texture, JobIdx);
+				ManifestSources.Textures.AddUnique(ChannelOption->Texture);
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JobReports;
+	int32 NumFailed = 0;
+	int32 NumSkipped = 0;
+	uint64 PeakUsedPhysical = 0;
+
+	// Packed textures are saved in batches, each batch with one round of source control requests
+	FPackSaveSession SaveSession(FakeSourceControl.Get());
+	TMap<FString, TSharedRef<FJsonObject>> UnsavedJobReports;
+	double SaveSeconds = 0.0;
+	double GarbageCollectSeconds = 0.0;
+	auto CollectPackGarbage = [&GarbageCollectSeconds]()
+	{
+		const double CollectStartTime = FPlatformTime::Seconds();
+		CollectGarbage(RF_NoFlags);
+		GarbageCollectSeconds += FPlatformTime::Seconds() - CollectStartTime;
+	};
+	auto FlushSaveSession = [&]()
+	{
+		const double SaveStartTime = FPlatformTime::Seconds();
+		for (const FString& FailedPackage : SaveSession.Flush())
+		{
+			if (const TSharedRef<FJsonObject>* JobReport = UnsavedJobReports.Find(FailedPackage))
+			{
+				++NumFailed;
+				(*JobReport)->SetBoolField(TEXT("Succeeded"), false);
+				(*JobReport)->SetStringField(TEXT("Error"), TEXT("Save failed"));
+			}
+		}
+		UnsavedJobReports.Reset();
+		SaveSeconds += FPlatformTime::Seconds() - SaveStartTime;
+
+		// Saved packages and released sources are no longer referenced, collecting them after every batch keeps
+		// memory of long manifests bounded
+		CollectPackGarbage();
+	};
+
+	for (int32 JobIdx = 0; JobIdx < Jobs.Num(); ++JobIdx)
+	{
+		const FManifestJob& ManifestJob = Jobs[JobIdx];
+		const FString PackageName = ManifestJob.Job.GetPackageName();
+
+		TSharedRef<FJsonObject> JobReport = MakeShared<FJsonObject>();
+		JobReport->SetStringField(TEXT("Package"), PackageName);
+
+		FPackStats Stats;
+		const bool bSucceeded = ManifestJob.Error.IsEmpty()
+								&& RunPackJob(ManifestJob.Job, &SourceCache, &Stats, &SaveSession) != nullptr;
+		if (!bSucceeded)
+		{
+			++NumFailed;
+			UE_LOG(LogTexturePackerCommandlet,
+				   Error,
+				   TEXT("Job %d (%s) failed: %s"),
+				   JobIdx,
+				   *PackageName,
+				   ManifestJob.Error.IsEmpty() ? TEXT("Pack failed") : *ManifestJob.Error);
+			JobReport->SetStringField(TEXT("Error"), ManifestJob.Error);
+		}
+
+		if (ManifestJob.Error.IsEmpty())
+		{
+			for (const FChannelOption* ChannelOption : ManifestJob.Job.GetChannelOptions())
+			{
+				if (ChannelOption->Texture != nullptr && LastJobOfTexture.FindRef(ChannelOption->Texture) == JobIdx)
+				{
+					SourceCache.Release(ChannelOption->Texture);
+					ManifestSources.Textures.RemoveSingleSwap(ChannelOption->Texture);
+				}
+			}
+		}
+
+		const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		PeakUsedPhysical = FMath::Max(PeakUsedPhysical, UsedPhysical);
+
+		NumSkipped += Stats.bSkipped ? 1 : 0;
+
+		JobReport->SetBoolField(TEXT("Succeeded"), bSucceeded);
+		JobReport->SetBoolField(TEXT("Skipped"), Stats.bSkipped);
+		JobReport->SetBoolField(TEXT("CacheHit"), Stats.bCacheHit);
+		JobReport->SetNumberField(TEXT("SizeX"), ManifestJob.Job.SizeX);
+		JobReport->SetNumberField(TEXT("SizeY"), ManifestJob.Job.SizeY);
+		JobReport->SetStringField(TEXT("Format"), GetFormatName(ResolvePackFormat(ManifestJob.Job)));
+		JobReport->SetNumberField(TEXT("PackMs"), Stats.PackSeconds * 1000.0);
+		JobReport->SetNumberField(TEXT("SaveMs"), Stats.SaveSeconds * 1000.0);
+		JobReport->SetNumberField(TEXT("PeakWorkingSetMiB"), ToMiB(Stats.PeakWorkingSetBytes));
+		JobReport->SetNumberField(TEXT("SourceCacheMiB"), ToMiB(SourceCache.GetAllocatedSize()));
+		JobReport->SetNumberField(TEXT("UsedPhysicalMiB"), ToMiB(UsedPhysical));
+		JobReports.Add(MakeShared<FJsonValueObject>(JobReport));
+
+		if (bSucceeded && !Stats.bSkipped)
+		{
+			UnsavedJobReports.Add(PackageName, JobReport);
+		}
+		if (SaveSession.Num() >= SaveBatchSize)
+		{
+			FlushSaveSession();
+		}
+	}
+
+	FlushSaveSession();
+
+	// Deferred builds compress in the background while later batches pack, only the remaining ones are waited for
+	const double BuildWaitStartTime = FPlatformTime::Seconds();
+	FTextureCompilingManager::Get().FinishAllCompilation();
+	const double BuildWaitSeconds = FPlatformTime::Seconds() - BuildWaitStartTime;
+	CollectPackGarbage();
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Manifest"), ManifestFilename);
+	Report->SetNumberField(TEXT("ManifestCrc"), ManifestInfo.Crc);
+	Report->SetNumberField(TEXT("NumManifestJobs"), ManifestInfo.NumJobs);
+	Report->SetNumberField(TEXT("Shard"), Shard.Index);
+	Report->SetNumberField(TEXT("NumShards"), Shard.Num);
+	Report->SetNumberField(TEXT("NumJobs"), Jobs.Num());
+	Report->SetNumberField(TEXT("NumFailed"), NumFailed);
+	Report->SetNumberField(TEXT("NumSkipped"), NumSkipped);
+	Report->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+	Report->SetNumberField(TEXT("SaveSeconds"), SaveSeconds);
+	Report->SetNumberField(TEXT("BuildWaitSeconds"), BuildWaitSeconds);
+	Report->SetNumberField(TEXT("GarbageCollectSeconds"), GarbageCollectSeconds);
+	Report->SetNumberField(TEXT("SourceControlRequests"), SaveSession.GetNumSourceControlRequests());
+	Report->SetNumberField(TEXT("PeakUsedPhysicalMiB"), ToMiB(PeakUsedPhysical));
+
+	const FPackCacheStats CacheStats = GetPackCacheStats();
+	Report->SetNumberField(TEXT("CacheHits"), CacheStats.Hits);
+	Report->SetNumberField(TEXT("CacheMisses"), CacheStats.Misses);
+	Report->SetNumberField(TEXT("CacheSavedMiB"), ToMiB(CacheStats.BytesSaved));
+
+	Report->SetArrayField(TEXT("Jobs"), JobReports);
+
+	if (!SaveReport(Report, ReportFilename))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogTexturePackerCommandlet,
+		   Display,
+		   TEXT("Shard %d of %d packed %d of %d textures (%d up to date) in %.1f s, report written to %s"),
+		   Shard.Index,
+		   Shard.Num,
+		   Jobs.Num() - NumFailed,
+		   Jobs.Num(),
+		   NumSkipped,
+		   TotalSeconds,
+		   *ReportFilename);
+
+	return NumFailed == 0 ? 0 : 1;
+}
+
+int32 UTexturePackerCommandlet::MergeShardReports(const FString& Params)
+{
+	using namespace TexturePacker;
+
+	int32 NumShards = 0;
+	if (!FParse::Value(*Params, TEXT("NumShards="), NumShards) || NumShards < 1)
+	{
+		UE_LOG(LogTexturePackerCommandlet,
+			   Error,
+			   TEXT("Usage: -run=TexturePacker -Merge -NumShards=M [-ReportDir=Dir] [-Report=merged.json]"));
+		return 1;
+	}
+
+	FString ReportDir = FPaths::ProjectSavedDir() / TEXT("TexturePacker");
+	FParse::Value(*Params, TEXT("ReportDir="), ReportDir);
+	FString ReportFilename = ReportDir / TEXT("PackReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportFilename);
+
+	TArray<TSharedPtr<FJsonValue>> JobReports;
+	TArray<TSharedPtr<FJsonValue>> ShardReports;
+	TArray<TSharedPtr<FJsonValue>> BadShards;
+	TOptional<FManifestInfo> ManifestInfo;
+	bool bAllShardsReported = true;
+	int32 NumJobs = 0;
+	int32 NumFailed = 0;
+	double WallSeconds = 0.0;
+	double TotalSeconds = 0.0;
+	FPackCacheStats CacheStats;
+
+	for (int32 ShardIdx = 0; ShardIdx < NumShards; ++ShardIdx)
+	{
+		const FString ShardFilename = GetShardReportFilename(ReportDir, {ShardIdx, NumShards});
+
+		// A shard that crashed or never ran leaves no report, one from another manifest or split is as bad
+		FString Status = TEXT("Succeeded");
+		FString Json;
+		TSharedPtr<FJsonObject> ShardReport;
+		FManifestInfo ShardManifest;
+		int32 ReportShard = INDEX_NONE;
+		int32 ReportNumShards = 0;
+		if (!FFileHelper::LoadFileToString(Json, *ShardFilename)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), ShardReport) || !ShardReport.IsValid())
+		{
+			Status = TEXT("Missing");
+			bAllShardsReported = false;
+		}
+		else if (!ShardReport->TryGetNumberField(TEXT("Shard"), ReportShard)
+				 || !ShardReport->TryGetNumberField(TEXT("NumShards"), ReportNumShards)
+				 || !ShardReport->TryGetNumberField(TEXT("ManifestCrc"), ShardManifest.Crc)
+				 || !ShardReport->TryGetNumberField(TEXT("NumManifestJobs"), ShardManifest.NumJobs)
+				 || ReportShard != ShardIdx || ReportNumShards != NumShards
+				 || (ManifestInfo.IsSet() && ManifestInfo->Crc != ShardManifest.Crc))
+		{
+			Status = TEXT("Mismatch");
+			bAllShardsReported = false;
+		}
+		else
+		{
+			ManifestInfo = ShardManifest;
+
+			const int32 ShardNumFailed = int32(ShardReport->GetNumberField(TEXT("NumFailed")));
+			const double ShardSeconds = ShardReport->GetNumberField(TEXT("TotalSeconds"));
+			NumJobs += int32(ShardReport->GetNumberField(TEXT("NumJobs")));
+			NumFailed += ShardNumFailed;
+			WallSeconds = FMath::Max(WallSeconds, ShardSeconds);
+			TotalSeconds += ShardSeconds;
+			JobReports.Append(ShardReport->GetArrayField(TEXT("Jobs")));
+
+			CacheStats.Hits += int64(ShardReport->GetNumberField(TEXT("CacheHits")));
+			CacheStats.Misses += int64(ShardReport->GetNumberField(TEXT("CacheMisses")));
+			CacheStats.BytesSaved += int64(ShardReport->GetNumberField(TEXT("CacheSavedMiB")) * 1024.0 * 1024.0);
+
+			if (ShardNumFailed > 0)
+			{
+				Status = TEXT("Failed");
+			}
+		}
+
+		if (Status != TEXT("Succeeded"))
+		{
+			UE_LOG(LogTexturePackerCommandlet, Error, TEXT("Shard %d: %s (%s)"), ShardIdx, *Status, *ShardFilename);
+			BadShards.Add(MakeShared<FJsonValueNumber>(ShardIdx));
+		}
+
+		TSharedRef<FJsonObject> ShardStatus = MakeShared<FJsonObject>();
+		ShardStatus->SetNumberField(TEXT("Shard"), ShardIdx);
+		ShardStatus->SetStringField(TEXT("Report"), ShardFilename);
+		ShardStatus->SetStringField(TEXT("Status"), Status);
+		ShardReports.Add(MakeShared<FJsonValueObject>(ShardStatus));
+	}
+
+	// With every shard present each manifest job has to be reported exactly once
+	const bool bJobsMatch = ManifestInfo.IsSet() && NumJobs == ManifestInfo->NumJobs;
+	if (bAllShardsReported && !bJobsMatch)
+	{
+		UE_LOG(LogTexturePackerCommandlet,
+			   Error,
+			   TEXT("Shards reported %d jobs, manifest has %d"),
+			   NumJobs,
+			   ManifestInfo.IsSet() ? ManifestInfo->NumJobs : 0);
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("NumShards"), NumShards);
+	Report->SetNumberField(TEXT("NumManifestJobs"), ManifestInfo.IsSet() ? ManifestInfo->NumJobs : 0);
+	Report->SetNumberField(TEXT("NumJobs"), NumJobs);
+	Report->SetNumberField(TEXT("NumFailed"), NumFailed);
+	Report->SetNumberField(TEXT("WallSeconds"), WallSeconds);
+	Report->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+	Report->SetNumberField(TEXT("CacheHits"), CacheStats.Hits);
+	Report->SetNumberField(TEXT("CacheMisses"), CacheStats.Misses);
+	Report->SetNumberField(TEXT("CacheSavedMiB"), ToMiB(CacheStats.BytesSaved));
+	Report->SetArrayField(TEXT("BadShards"), BadShards);
+	Report->SetArrayField(TEXT("Shards"), ShardReports);
+	Report->SetArrayField(TEXT("Jobs"), JobReports);
+
+	if (!SaveReport(Report, ReportFilename))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogTexturePackerCommandlet,
+		   Display,
+		   TEXT("Merged %d shards, %d of %d jobs reported, %d failed, %d bad shards, report written to %s"),
+		   NumShards,
+		   NumJobs,
+		   ManifestInfo.IsSet() ? ManifestInfo->NumJobs : 0,
+		   NumFailed,
+		   BadShards.Num(),
+		   *ReportFilename);
+
+	return BadShards.Num() == 0 && bJobsMatch ? 0 : 1;
+}
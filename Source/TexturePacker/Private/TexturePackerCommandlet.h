@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "TexturePackerCommandlet.generated.h"
+
+/**
+ * Packs every job of a manifest without any UI.
+ *
+ * UnrealEditor-Cmd Project.uproject -run=TexturePacker -Manifest=packs.json [-Report=report.json] [-MaxWorkers=N]
+ *
+ * Jobs whose output was packed from the same sources and options are skipped, -Force packs them anyway.
+ *
+ * Jobs can be split across machines with -Shard=N -NumShards=M, every shard writes PackReport_N_of_M.json to
+ * -ReportDir. Once all shards finished, -run=TexturePacker -Merge -NumShards=M [-ReportDir=Dir] combines their reports
+ * and fails when a shard is missing, failed or packed a different manifest.
+ *
+ * Manifest is a json object with a "Jobs" array. Every job has "PackagePath", "TextureName", optional "SizeX" and
+ * "SizeY" (smallest source size when missing), optional "Format" (Auto, BGRA8, G8, G16, RGBA16 or RGBA16F, BGRA8 when
+ * missing) and "Red", "Green", "Blue" and optional "Alpha" channels. A channel is
+ * {"Texture": "/Game/T_Source.T_Source", "Channel": "R", "Invert": false, "KeepSrgb": false}, fill channels use
+ * "White" or "Black" and no texture.
+ */
+UCLASS()
+class UTexturePackerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTexturePackerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 PackManifest(const FString& Params);
+
+	int32 MergeShardReports(const FString& Params);
+};
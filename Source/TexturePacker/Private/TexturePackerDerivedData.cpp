@@ -0,0 +1,81 @@
+#include "TexturePackerDerivedData.h"
+
+#include "DerivedDataCacheInterface.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerDerivedData, Log, All);
+
+namespace TexturePacker
+{
+namespace
+{
+/** Change to invalidate every cached pack, PackerVersion in the content hash covers pixel changes */
+const TCHAR* PackCacheVersion = TEXT("8B0F6A1D2C3E4F5061728394A5B6C7D8");
+
+std::atomic<int64> CacheHits{0};
+std::atomic<int64> CacheMisses{0};
+std::atomic<int64> CacheBytesSaved{0};
+
+/** Cached values are fetched into TArray with int32 size, larger packs are never cached */
+bool CanCachePixels(const FString& CacheKey, const int64 NumBytes)
+{
+	if (NumBytes <= MAX_int32)
+	{
+		return true;
+	}
+
+	UE_LOG(LogTexturePackerDerivedData,
+		   Log,
+		   TEXT("Skipped derived data cache for %s, %lld bytes do not fit a cache value"),
+		   *CacheKey,
+		   NumBytes);
+	return false;
+}
+}  // namespace
+
+FString GetPackCacheKey(const FString& ContentHash)
+{
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("TEXPACK"), PackCacheVersion, *ContentHash);
+}
+
+bool LoadCachedPixels(const FString& CacheKey, uint8* Dst, const int64 NumBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::LoadCachedPixels);
+
+	if (!CanCachePixels(CacheKey, NumBytes))
+	{
+		return false;
+	}
+
+	TArray<uint8> Data;
+	if (!GetDerivedDataCacheRef().GetSynchronous(*CacheKey, Data, TEXT("TexturePacker")) || Data.Num() != NumBytes)
+	{
+		++CacheMisses;
+		return false;
+	}
+
+	FMemory::Memcpy(Dst, Data.GetData(), NumBytes);
+	++CacheHits;
+	CacheBytesSaved += NumBytes;
+	return true;
+}
+
+void StoreCachedPixels(const FString& CacheKey, const uint8* Pixels, const int64 NumBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::StoreCachedPixels);
+
+	if (!CanCachePixels(CacheKey, NumBytes))
+	{
+		return;
+	}
+
+	GetDerivedDataCacheRef().Put(*CacheKey, TArrayView64<const uint8>(Pixels, NumBytes), TEXT("TexturePacker"));
+}
+
+FPackCacheStats GetPackCacheStats()
+{
+	return {CacheHits.load(), CacheMisses.load(), CacheBytesSaved.load()};
+}
+}  // namespace TexturePacker
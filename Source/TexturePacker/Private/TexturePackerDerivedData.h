@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TexturePacker
+{
+/** Packed pixel cache totals since editor start */
+struct FPackCacheStats
+{
+	int64 Hits = 0;
+	int64 Misses = 0;
+	/** Packed pixel bytes fetched from the cache instead of being packed */
+	int64 BytesSaved = 0;
+};
+
+/** Derived data cache key of packed pixels with given content hash, see ComputePackContentHash */
+FString GetPackCacheKey(const FString& ContentHash);
+
+/**
+ * @brief Fetch packed pixels from the derived data cache
+ *
+ * @param Dst Destination pixels, must hold NumBytes bytes
+ * @return Whether Dst was filled, cached data of different size counts as a miss. Packs above MAX_int32 bytes are
+ * never cached and always return false
+ */
+bool LoadCachedPixels(const FString& CacheKey, uint8* Dst, const int64 NumBytes);
+
+/** Store packed pixels in the derived data cache, skipped with a log line for packs above MAX_int32 bytes */
+void StoreCachedPixels(const FString& CacheKey, const uint8* Pixels, const int64 NumBytes);
+
+FPackCacheStats GetPackCacheStats();
+}  // namespace TexturePacker
@@ -0,0 +1,264 @@
+#include "TexturePackerJob.h"
+
+#include "Algo/AnyOf.h"
+#include "Engine/Texture.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
+#include "TexturePackerAssetUserData.h"
+#include "TexturePackerSettings.h"
+#include "TexturePackerSourceCache.h"
+
+namespace TexturePacker
+{
+namespace
+{
+/** Text form of everything that determines the packed pixels, source paths only when asked for */
+FString BuildJobKey(const FPackJob& Job, const bool bIncludeSourcePaths)
+{
+	FString Key = FString::Printf(TEXT("v%d|%dx%d|format%d|filter%d"),
+								  PackerVersion,
+								  Job.SizeX,
+								  Job.SizeY,
+								  int32(ResolvePackFormat(Job)),
+								  int32(GetDefault<UTexturePackerSettings>()->ResizeFilter));
+
+	// HDR mapping only matters when HDR sources are packed into unorm pixels
+	const bool bHdrSource = Algo::AnyOf(Job.GetChannelOptions(),
+										[](const FChannelOption* ChannelOption)
+										{
+											return ChannelOption->Texture != nullptr
+												   && IsHdrSourceFormat(ChannelOption->Texture->Source.GetFormat());
+										});
+	if (bHdrSource && ResolvePackFormat(Job) != EPackFormat::RGBA16F)
+	{
+		Key += FString::Printf(TEXT("|hdr%d"), int32(GetDefault<UTexturePackerSettings>()->HdrMapping));
+	}
+
+	for (const FChannelOption* ChannelOption : Job.GetChannelOptions())
+	{
+		Key += FString::Printf(TEXT("|%d:%d:%d"),
+							   int32(ChannelOption->Channel),
+							   int32(ChannelOption->bInvert),
+							   int32(ChannelOption->bKeepSrgb));
+
+		if (const UTexture* Texture = ChannelOption->Texture)
+		{
+			Key += FString::Printf(
+				TEXT(":%s:%d"), *Texture->Source.GetId().ToString(EGuidFormats::Digits), int32(Texture->SRGB));
+			if (bIncludeSourcePaths)
+			{
+				Key += TEXT(":") + Texture->GetPathName();
+			}
+		}
+	}
+
+	return Key;
+}
+
+FString HashKey(const FString& Key)
+{
+	const FTCHARToUTF8 Utf8(*Key);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+	return Hash.ToString();
+}
+}  // namespace
+
+EPackFormat ResolvePackFormat(const FPackJob& Job)
+{
+	if (Job.Format != EPackFormat::Auto)
+	{
+		return Job.Format;
+	}
+
+	bool b16Bit = false;
+	for (const FChannelOption* ChannelOption : Job.GetChannelOptions())
+	{
+		if (ChannelOption->Texture != nullptr)
+		{
+			const ETextureSourceFormat SourceFormat = ChannelOption->Texture->Source.GetFormat();
+			if (IsHdrSourceFormat(SourceFormat))
+			{
+				return EPackFormat::RGBA16F;
+			}
+			b16Bit |= GetSourceLayout(SourceFormat).SampleType == ESampleType::U16;
+		}
+	}
+
+	// Single channel textures read back the same value in red, green and blue, so green and blue must really repeat
+	// red. Black ones stay black in BGRA8 and would turn into red in G8
+	auto RepeatsRed = [&Job](const FChannelOption& Option)
+	{
+		return Option.Texture == Job.Red.Texture && Option.Channel == Job.Red.Channel
+			   && Option.bInvert == Job.Red.bInvert && Option.bKeepSrgb == Job.Red.bKeepSrgb;
+	};
+	if (!Job.Alpha.IsSet() && RepeatsRed(Job.Green) && RepeatsRed(Job.Blue))
+	{
+		return b16Bit ? EPackFormat::G16 : EPackFormat::G8;
+	}
+	return b16Bit ? EPackFormat::RGBA16 : EPackFormat::BGRA8;
+}
+
+int32 GetPackBytesPerPixel(const EPackFormat Format)
+{
+	switch (Format)
+	{
+		case EPackFormat::G8:
+			return 1;
+		case EPackFormat::G16:
+			return 2;
+		case EPackFormat::RGBA16:
+		case EPackFormat::RGBA16F:
+			return 8;
+		default:
+			return 4;
+	}
+}
+
+int64 GetPackedBytes(const FPackJob& Job)
+{
+	return GetPackedMipBytes(Job, 0);
+}
+
+bool IsPackSRGB(const FPackJob& Job)
+{
+	// Wide formats are always linear, RGB keeps sRGB only if every color channel asked for it
+	switch (ResolvePackFormat(Job))
+	{
+		case EPackFormat::G8:
+			return Job.Red.bKeepSrgb;
+		case EPackFormat::BGRA8:
+			return Job.Red.bKeepSrgb && Job.Green.bKeepSrgb && Job.Blue.bKeepSrgb;
+		default:
+			return false;
+	}
+}
+
+int32 GetPackNumMips(const FPackJob& Job)
+{
+	if (!GetDefault<UTexturePackerSettings>()->bGenerateMips || !FMath::IsPowerOfTwo(Job.SizeX)
+		|| !FMath::IsPowerOfTwo(Job.SizeY))
+	{
+		return 1;
+	}
+	return FMath::FloorLog2(FMath::Max(Job.SizeX, Job.SizeY)) + 1;
+}
+
+int64 GetPackedMipBytes(const FPackJob& Job, const int32 MipIndex)
+{
+	const int32 MipSizeX = FMath::Max(1, Job.SizeX >> MipIndex);
+	const int32 MipSizeY = FMath::Max(1, Job.SizeY >> MipIndex);
+	return int64(MipSizeX) * MipSizeY * GetPackBytesPerPixel(ResolvePackFormat(Job));
+}
+
+int64 GetPackedMipChainBytes(const FPackJob& Job)
+{
+	int64 Bytes = 0;
+	for (int32 MipIndex = 0; MipIndex < GetPackNumMips(Job); ++MipIndex)
+	{
+		Bytes += GetPackedMipBytes(Job, MipIndex);
+	}
+	return Bytes;
+}
+
+void CopyPackedMips(const FPackJob& Job, const uint8* MipChain, TArrayView<uint8* const> Mips)
+{
+	check(Mips.Num() == GetPackNumMips(Job));
+
+	for (int32 MipIndex = 0; MipIndex < Mips.Num(); ++MipIndex)
+	{
+		const int64 MipBytes = GetPackedMipBytes(Job, MipIndex);
+		FMemory::Memcpy(Mips[MipIndex], MipChain, MipBytes);
+		MipChain += MipBytes;
+	}
+}
+
+FString ComputePackFingerprint(const FPackJob& Job)
+{
+	// Mips are generated from the packed pixels when saving, so they don't change the content hash
+	return HashKey(BuildJobKey(Job, true)
+				   + FString::Printf(TEXT("|mips%d"), int32(GetDefault<UTexturePackerSettings>()->bGenerateMips)));
+}
+
+FString ComputePackContentHash(const FPackJob& Job)
+{
+	return HashKey(BuildJobKey(Job, false));
+}
+
+UTexture* FindUpToDatePack(const FPackJob& Job, const FString& Fingerprint)
+{
+	const FString PackageName = Job.GetPackageName();
+	if (FindPackage(nullptr, *PackageName) == nullptr && !FPackageName::DoesPackageExist(PackageName))
+	{
+		return nullptr;
+	}
+
+	UTexture* Existing = LoadObject<UTexture>(
+		nullptr, *(PackageName + TEXT(".") + Job.TextureName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+	if (Existing == nullptr)
+	{
+		return nullptr;
+	}
+
+	const UTexturePackerAssetUserData* UserData = UTexturePackerAssetUserData::Find(Existing);
+	return UserData != nullptr && UserData->Fingerprint == Fingerprint ? Existing : nullptr;
+}
+
+void RecordPackJob(UTexture* Texture, const FPackJob& Job, const FString& Fingerprint)
+{
+	UTexturePackerAssetUserData* UserData = NewObject<UTexturePackerAssetUserData>(Texture);
+	UserData->Fingerprint = Fingerprint;
+	UserData->Format = uint8(Job.Format);
+
+	for (const FChannelOption* ChannelOption : Job.GetChannelOptions())
+	{
+		FTexturePackerChannelRecord& Record = UserData->Channels.AddDefaulted_GetRef();
+		Record.Texture = ChannelOption->Texture;
+		Record.Channel = uint8(ChannelOption->Channel);
+		Record.bInvert = ChannelOption->bInvert;
+		Record.bKeepSrgb = ChannelOption->bKeepSrgb;
+	}
+
+	Texture->AddAssetUserData(UserData);
+}
+
+TOptional<FPackJob> GetRecordedPackJob(const UTexture* Packed)
+{
+	const UTexturePackerAssetUserData* UserData =
+		Packed != nullptr ? UTexturePackerAssetUserData::Find(Packed) : nullptr;
+	if (UserData == nullptr || UserData->Channels.Num() < 3)
+	{
+		return {};
+	}
+
+	FPackJob Job;
+	Job.PackagePath = FPackageName::GetLongPackagePath(Packed->GetOutermost()->GetName());
+	Job.TextureName = Packed->GetName();
+	Job.SizeX = Packed->Source.GetSizeX();
+	Job.SizeY = Packed->Source.GetSizeY();
+	Job.Format = EPackFormat(UserData->Format);
+
+	FChannelOption* const Options[] = {&Job.Red, &Job.Green, &Job.Blue};
+	for (int32 ChannelIdx = 0; ChannelIdx < UserData->Channels.Num(); ++ChannelIdx)
+	{
+		const FTexturePackerChannelRecord& Record = UserData->Channels[ChannelIdx];
+		const FChannelOption Option{
+			Record.Texture.LoadSynchronous(), EChannel(Record.Channel), Record.bInvert, Record.bKeepSrgb};
+		if (!Record.Texture.IsNull() && Option.Texture == nullptr)
+		{
+			return {};
+		}
+
+		if (ChannelIdx < UE_ARRAY_COUNT(Options))
+		{
+			*Options[ChannelIdx] = Option;
+		}
+		else
+		{
+			Job.Alpha = Option;
+		}
+	}
+
+	return Job;
+}
+}  // namespace TexturePacker
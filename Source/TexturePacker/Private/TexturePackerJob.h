@@ -0,0 +1,233 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TexturePacker.h"
+
+#include <atomic>
+
+namespace TexturePacker
+{
+class FDecodedSourceCache;
+class FPackSaveSession;
+
+/** Part of every fingerprint, bump whenever packed pixels for the same inputs change */
+constexpr int32 PackerVersion = 4;
+
+/** Everything PackTexture needs to create one packed texture */
+struct FPackJob
+{
+	FString PackagePath;
+	FString TextureName;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	FChannelOption Red{nullptr, EChannel::Black};
+	FChannelOption Green{nullptr, EChannel::Black};
+	FChannelOption Blue{nullptr, EChannel::Black};
+	TOptional<FChannelOption> Alpha;
+	EPackFormat Format = EPackFormat::BGRA8;
+	/** Pack even when the existing output has the same fingerprint */
+	bool bForce = false;
+
+	FString GetPackageName() const
+	{
+		return PackagePath / TextureName;
+	}
+
+	/** Packed channel options in RGBA order, alpha only when it is set */
+	TArray<const FChannelOption*, TInlineAllocator<4>> GetChannelOptions() const
+	{
+		TArray<const FChannelOption*, TInlineAllocator<4>> Options{&Red, &Green, &Blue};
+		if (Alpha.IsSet())
+		{
+			Options.Add(&Alpha.GetValue());
+		}
+		return Options;
+	}
+};
+
+/** Format the job is packed in, Auto is resolved from its channels and the formats of their sources */
+EPackFormat ResolvePackFormat(const FPackJob& Job);
+
+/** Bytes of one pixel in given resolved format */
+int32 GetPackBytesPerPixel(const EPackFormat Format);
+
+/** Bytes of all packed pixels of the job in mip 0 */
+int64 GetPackedBytes(const FPackJob& Job);
+
+/** Whether the packed texture samples its color channels as sRGB */
+bool IsPackSRGB(const FPackJob& Job);
+
+/** Mips stored in the packed texture, the full chain when bGenerateMips is set and both sizes are powers of two */
+int32 GetPackNumMips(const FPackJob& Job);
+
+/** Bytes of packed pixels in given mip of the job */
+int64 GetPackedMipBytes(const FPackJob& Job, const int32 MipIndex);
+
+/** Bytes of every stored mip of the job, packed one after another starting with mip 0 */
+int64 GetPackedMipChainBytes(const FPackJob& Job);
+
+/** Copy every mip of a packed mip chain to its own destination, like the locked mips of a texture source */
+void CopyPackedMips(const FPackJob& Job, const uint8* MipChain, TArrayView<uint8* const> Mips);
+
+/** Timings and memory of a single pack */
+struct FPackStats
+{
+	double PackSeconds = 0.0;
+	double SaveSeconds = 0.0;
+	/** Peak bytes held by decoded sources or streaming buffers, the packed mip is not included */
+	int64 PeakWorkingSetBytes = 0;
+	/** Existing output was up to date and nothing was packed */
+	bool bSkipped = false;
+	/** Pixels came from the derived data cache */
+	bool bCacheHit = false;
+};
+
+/**
+ * @brief Progress and cancellation of one pack, shared between the thread packing it and the one waiting for it
+ *
+ * Work is counted in rows, the packer adds all of its work up front and completes it as bands finish.
+ */
+class FPackProgress
+{
+public:
+	void AddWork(const int64 Work)
+	{
+		TotalWork += Work;
+	}
+
+	void CompleteWork(const int64 Work)
+	{
+		DoneWork += Work;
+	}
+
+	/** Completed part of the work, 0 before the packer started */
+	float GetFraction() const
+	{
+		const int64 Total = TotalWork.load();
+		return Total > 0 ? float(double(DoneWork.load()) / Total) : 0.f;
+	}
+
+	/** Ask the packer to stop, it returns at the next band */
+	void Cancel()
+	{
+		bCancelled = true;
+	}
+
+	bool IsCancelled() const
+	{
+		return bCancelled.load();
+	}
+
+private:
+	std::atomic<int64> TotalWork{0};
+	std::atomic<int64> DoneWork{0};
+	std::atomic<bool> bCancelled{false};
+};
+
+/**
+ * @brief Hash of everything that determines the packed pixels
+ *
+ * Covers source texture paths, source IDs and sRGB flags, channel options, target size and format, resize filter, HDR
+ * mapping of half sources packed into unorm pixels, whether mips are generated and PackerVersion. Any change to a
+ * source asset gives it a new source ID and so a new fingerprint.
+ */
+FString ComputePackFingerprint(const FPackJob& Job);
+
+/**
+ * @brief Hash of the packed pixels content, the fingerprint without any asset paths
+ *
+ * Same sources packed with the same options into differently named textures, or in another project branch, give
+ * the same hash.
+ */
+FString ComputePackContentHash(const FPackJob& Job);
+
+/** Existing output of the job if it was packed with given fingerprint, null when it has to be packed */
+UTexture* FindUpToDatePack(const FPackJob& Job, const FString& Fingerprint);
+
+/** Store fingerprint and channel options of the job on the packed texture */
+void RecordPackJob(UTexture* Texture, const FPackJob& Job, const FString& Fingerprint);
+
+/**
+ * @brief Rebuild the job that packed given texture from its recorded channel options
+ *
+ * Loads recorded sources. Returns nothing when the texture was not packed or a source no longer exists.
+ */
+TOptional<FPackJob> GetRecordedPackJob(const UTexture* Packed);
+
+/** Existing output when the job is not forced and its fingerprint matches, logs and fills OutStats for skipped job */
+UTexture* FindSkippedPack(const FPackJob& Job, const FString& Fingerprint, FPackStats* OutStats);
+
+/**
+ * @brief Fill pixels of several jobs, from the derived data cache or in one pass over their sources
+ *
+ * Every source is decoded once for all jobs that read it, and jobs of the same size are filled in the same sweep over
+ * the decoded rows. Streaming packs jobs one at a time. Only reads UObjects, so it may run on any thread while the
+ * sources are kept alive and unchanged.
+ *
+ * Jobs that store mips get them generated right after their mip 0, on the calling thread and its band workers.
+ *
+ * @param Dsts Destination mip chain of every job in its resolved format, each must hold GetPackedMipChainBytes of its
+ * job
+ * @param SourceCache Decoded sources shared with other jobs, a local cache is used when null. Ignored when streaming
+ * @param OnPacked Called on the calling thread as soon as pixels of a job are complete
+ * @return False when cancelled or a job could not be packed, jobs not reported through OnPacked are left incomplete
+ */
+bool PackJobsPixels(TArrayView<const FPackJob> Jobs,
+					TArrayView<uint8* const> Dsts,
+					FDecodedSourceCache* SourceCache,
+					FPackProgress& Progress,
+					TFunctionRef<void(int32 JobIdx, const FPackStats& Stats)> OnPacked);
+
+/**
+ * @brief Fill pixels of the job, from the derived data cache or by packing its sources
+ *
+ * Only reads UObjects, so it may run on any thread while the sources are kept alive and unchanged.
+ *
+ * @param Dst Destination mip chain in the resolved format of the job, must hold GetPackedMipChainBytes of the job
+ * @param SourceCache Decoded sources shared with other jobs, a local cache is used when null. Ignored when streaming
+ * @return False when cancelled or the job could not be packed, Dst is left incomplete
+ */
+bool PackJobPixels(const FPackJob& Job,
+				   uint8* Dst,
+				   FDecodedSourceCache* SourceCache,
+				   FPackProgress& Progress,
+				   FPackStats* OutStats);
+
+/**
+ * @brief Create the packed texture, fill its pixels and save it, on the game thread
+ *
+ * Mips are only copied here, all pixel work happens in WritePixels or before it.
+ *
+ * @param WritePixels Fills every locked mip, returning false discards the texture without saving
+ * @param SaveSession Queues the package for a batched save when set, otherwise it is saved right away. With
+ * bDeferTextureBuild the texture is also built by the session, after the package is saved
+ */
+UTexture* SavePackedTexture(const FPackJob& Job,
+							const FString& Fingerprint,
+							TFunctionRef<bool(TArrayView<uint8* const> Mips)> WritePixels,
+							FPackStats* OutStats,
+							FPackSaveSession* SaveSession = nullptr);
+
+/**
+ * @brief Pack, create and save texture described by the job
+ *
+ * Returns existing texture without packing when its fingerprint matches the job, unless the job is forced.
+ *
+ * @param SourceCache Decoded sources shared with other jobs, a local cache is used when null. Ignored when streaming
+ * @param OutStats Optional timings and memory of this job
+ * @param SaveSession Queues the package for a batched save when set, otherwise it is saved right away
+ */
+UTexture* RunPackJob(const FPackJob& Job,
+					 FDecodedSourceCache* SourceCache = nullptr,
+					 FPackStats* OutStats = nullptr,
+					 FPackSaveSession* SaveSession = nullptr);
+
+/**
+ * @brief Pack, create and save textures of several jobs in one pass over their shared sources
+ *
+ * Up to date outputs are returned without packing, like in RunPackJob. Game thread only.
+ *
+ * @return Texture of every job in job order
+ */
+TArray<UTexture*> RunPackJobs(TArrayView<const FPackJob> Jobs, FDecodedSourceCache* SourceCache = nullptr);
+}  // namespace TexturePacker
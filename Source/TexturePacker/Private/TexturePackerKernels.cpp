@@ -0,0 +1,628 @@
+#include "TexturePackerKernels.h"
+
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+#include "TexturePackerSettings.h"
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+#include <immintrin.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#endif
+
+// Every AVX2 capable CPU has F16C as well
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS \
+	&& (PLATFORM_ALWAYS_HAS_AVX_2 || (defined(PLATFORM_ALWAYS_HAS_F16C) && PLATFORM_ALWAYS_HAS_F16C))
+#define TEXTUREPACKER_F16C 1
+#else
+#define TEXTUREPACKER_F16C 0
+#endif
+
+namespace TexturePacker
+{
+// clang-format off
+// Copied form Math\Color.cpp. Wasn't in exported symbols
+const float sRGBToLinearTable[256] =
+{
+	0.0f,
+	0.000303526983548838f, 0.000607053967097675f, 0.000910580950646512f, 0.00121410793419535f, 0.00151763491774419f,
+	0.00182116190129302f, 0.00212468888484186f, 0.0024282158683907f, 0.00273174285193954f, 0.00303526983548838f,
+	0.00334653564113713f, 0.00367650719436314f, 0.00402471688178252f, 0.00439144189356217f, 0.00477695332960869f,
+	0.005181516543916f, 0.00560539145834456f, 0.00604883284946662f, 0.00651209061157708f, 0.00699540999852809f,
+	0.00749903184667767f, 0.00802319278093555f, 0.0085681254056307f, 0.00913405848170623f, 0.00972121709156193f,
+	0.0103298227927056f, 0.0109600937612386f, 0.0116122449260844f, 0.012286488094766f, 0.0129830320714536f,
+	0.0137020827679224f, 0.0144438433080002f, 0.0152085141260192f, 0.0159962930597398f, 0.0168073754381669f,
+	0.0176419541646397f, 0.0185002197955389f, 0.0193823606149269f, 0.0202885627054049f, 0.0212190100154473f,
+	0.0221738844234532f, 0.02315336579873f, 0.0241576320596103f, 0.0251868592288862f, 0.0262412214867272f,
+	0.0273208912212394f, 0.0284260390768075f, 0.0295568340003534f, 0.0307134432856324f, 0.0318960326156814f,
+	0.0331047661035236f, 0.0343398063312275f, 0.0356013143874111f, 0.0368894499032755f, 0.0382043710872463f,
+	0.0395462347582974f, 0.0409151963780232f, 0.0423114100815264f, 0.0437350287071788f, 0.0451862038253117f,
+	0.0466650857658898f, 0.0481718236452158f, 0.049706565391714f, 0.0512694577708345f, 0.0528606464091205f,
+	0.0544802758174765f, 0.0561284894136735f, 0.0578054295441256f, 0.0595112375049707f, 0.0612460535624849f,
+	0.0630100169728596f, 0.0648032660013696f, 0.0666259379409563f, 0.0684781691302512f, 0.070360094971063f,
+	0.0722718499453493f, 0.0742135676316953f, 0.0761853807213167f, 0.0781874210336082f, 0.0802198195312533f,
+	0.0822827063349132f, 0.0843762107375113f, 0.0865004612181274f, 0.0886555854555171f, 0.0908417103412699f,
+	0.0930589619926197f, 0.0953074657649191f, 0.0975873462637915f, 0.0998987273569704f, 0.102241732185838f,
+	0.104616483176675f, 0.107023102051626f, 0.109461709839399f, 0.1119324268857f, 0.114435372863418f,
+	0.116970666782559f, 0.119538426999953f, 0.122138771228724f, 0.124771816547542f, 0.127437679409664f,
+	0.130136475651761f, 0.132868320502552f, 0.135633328591233f, 0.138431613955729f, 0.141263290050755f,
+	0.144128469755705f, 0.147027265382362f, 0.149959788682454f, 0.152926150855031f, 0.155926462553701f,
+	0.158960833893705f, 0.162029374458845f, 0.16513219330827f, 0.168269398983119f, 0.171441099513036f,
+	0.174647402422543f, 0.17788841473729f, 0.181164242990184f, 0.184474993227387f, 0.187820771014205f,
+	0.191201681440861f, 0.194617829128147f, 0.198069318232982f, 0.201556252453853f, 0.205078735036156f,
+	0.208636868777438f, 0.212230756032542f, 0.215860498718652f, 0.219526198320249f, 0.223227955893977f,
+	0.226965872073417f, 0.23074004707378f, 0.23455058069651f, 0.238397572333811f, 0.242281120973093f,
+	0.246201325201334f, 0.250158283209375f, 0.254152092796134f, 0.258182851372752f, 0.262250655966664f,
+	0.266355603225604f, 0.270497789421545f, 0.274677310454565f, 0.278894261856656f, 0.283148738795466f,
+	0.287440836077983f, 0.291770648154158f, 0.296138269120463f, 0.300543792723403f, 0.304987312362961f,
+	0.309468921095997f, 0.313988711639584f, 0.3185467763743f, 0.323143207347467f, 0.32777809627633f,
+	0.332451534551205f, 0.337163613238559f, 0.341914423084057f, 0.346704054515559f, 0.351532597646068f,
+	0.356400142276637f, 0.361306777899234f, 0.36625259369956f, 0.371237678559833f, 0.376262121061519f,
+	0.381326009488037f, 0.386429431827418f, 0.39157247577492f, 0.396755228735618f, 0.401977777826949f,
+	0.407240209881218f, 0.41254261144808f, 0.417885068796976f, 0.423267667919539f, 0.428690494531971f,
+	0.434153634077377f, 0.439657171728079f, 0.445201192387887f, 0.450785780694349f, 0.456411021020965f,
+	0.462076997479369f, 0.467783793921492f, 0.473531493941681f, 0.479320180878805f, 0.485149937818323f,
+	0.491020847594331f, 0.496932992791578f, 0.502886455747457f, 0.50888131855397f, 0.514917663059676f,
+	0.520995570871595f, 0.527115123357109f, 0.533276401645826f, 0.539479486631421f, 0.545724458973463f,
+	0.552011399099209f, 0.558340387205378f, 0.56471150325991f, 0.571124827003694f, 0.577580437952282f,
+	0.584078415397575f, 0.590618838409497f, 0.597201785837643f, 0.603827336312907f, 0.610495568249093f,
+	0.617206559844509f, 0.623960389083534f, 0.630757133738175f, 0.637596871369601f, 0.644479679329661f,
+	0.651405634762384f, 0.658374814605461f, 0.665387295591707f, 0.672443154250516f, 0.679542466909286f,
+	0.686685309694841f, 0.693871758534824f, 0.701101889159085f, 0.708375777101046f, 0.71569349769906f,
+	0.723055126097739f, 0.730460737249286f, 0.737910405914797f, 0.745404206665559f, 0.752942213884326f,
+	0.760524501766589f, 0.768151144321824f, 0.775822215374732f, 0.783537788566466f, 0.791297937355839f,
+	0.799102735020525f, 0.806952254658248f, 0.81484656918795f, 0.822785751350956f, 0.830769873712124f,
+	0.838799008660978f, 0.846873228412837f, 0.854992605009927f, 0.863157210322481f, 0.871367116049835f,
+	0.879622393721502f, 0.887923114698241f, 0.896269350173118f, 0.904661171172551f, 0.913098648557343f,
+	0.921581853023715f, 0.930110855104312f, 0.938685725169219f, 0.947306533426946f, 0.955973349925421f,
+	0.964686244552961f, 0.973445287039244f, 0.982250546956257f, 0.991102093719252f, 1.0f
+};
+// clang-format on
+
+uint8 ToGammaSpaceFromLinear(const float In, const bool bSRGB)
+{
+	float Out = FMath::Clamp(In, 0.0f, 1.0f);
+
+	if (bSRGB)
+	{
+		Out = Out <= 0.0031308f ? Out * 12.92f : FMath::Pow(Out, 1.0f / 2.4f) * 1.055f - 0.055f;
+	}
+
+	return uint8(FMath::FloorToInt(Out * 255.999f));
+}
+
+FColorTables::FColorTables()
+{
+	for (int32 Value = 0; Value <= MAX_uint8; ++Value)
+	{
+		const float Linear = sRGBToLinearTable[Value];
+		Identity[Value] = uint8(Value);
+		Invert[Value] = uint8(MAX_uint8 - Value);
+		SRGBToLinear[Value] = uint8(FMath::FloorToInt(Linear * 255.999f));
+		SRGBToLinearInverted[Value] = uint8(FMath::FloorToInt((1.f - Linear) * 255.999f));
+	}
+
+	for (int32 Index = 0; Index < LinearToSRGBSize; ++Index)
+	{
+		LinearToSRGB[Index] = ToGammaSpaceFromLinear(Index / float(LinearToSRGBSize - 1), true);
+	}
+
+	for (int32 Value = 0; Value <= MAX_uint16; ++Value)
+	{
+		Unorm16To8[Value] = uint8(uint32(Value) * MAX_uint8 / MAX_uint16);
+	}
+}
+
+const FColorTables& FColorTables::Get()
+{
+	static const FColorTables Tables;
+	return Tables;
+}
+
+const uint8* FColorTables::GetChannelTable(const bool bConvertSRGB, const bool bInvert) const
+{
+	if (bConvertSRGB)
+	{
+		return bInvert ? SRGBToLinearInverted : SRGBToLinear;
+	}
+	return bInvert ? Invert : Identity;
+}
+
+FWideColorTables::FWideColorTables()
+{
+	for (int32 Value = 0; Value <= MAX_uint8; ++Value)
+	{
+		const float Unorm = Value / float(MAX_uint8);
+		const float Linear = sRGBToLinearTable[Value];
+		Unorm8To16[Value] = uint16(Value * 257);
+		SRGBToLinear16[Value] = uint16(FMath::RoundToInt(Linear * MAX_uint16));
+
+		const float Floats[4] = {Unorm, 1.f - Unorm, Linear, 1.f - Linear};
+		uint16 Halves[4];
+		FloatToHalf(Floats, 4, Halves);
+		Unorm8ToHalf[0][0][Value] = Halves[0];
+		Unorm8ToHalf[0][1][Value] = Halves[1];
+		Unorm8ToHalf[1][0][Value] = Halves[2];
+		Unorm8ToHalf[1][1][Value] = Halves[3];
+	}
+
+	// Every 16 bit value once, converted in batches
+	constexpr int32 NumValues = MAX_uint16 + 1;
+	TArray<uint16> Values;
+	TArray<float> Floats;
+	Values.SetNumUninitialized(NumValues);
+	Floats.SetNumUninitialized(NumValues);
+	for (int32 Value = 0; Value < NumValues; ++Value)
+	{
+		Values[Value] = uint16(Value);
+	}
+
+	for (int32 Value = 0; Value < NumValues; ++Value)
+	{
+		Floats[Value] = Value / float(MAX_uint16);
+	}
+	FloatToHalf(Floats.GetData(), NumValues, Unorm16ToHalf[0]);
+	for (int32 Value = 0; Value < NumValues; ++Value)
+	{
+		Floats[Value] = 1.f - Value / float(MAX_uint16);
+	}
+	FloatToHalf(Floats.GetData(), NumValues, Unorm16ToHalf[1]);
+
+	HalfToFloat(Values.GetData(), NumValues, Floats.GetData());
+	for (int32 Value = 0; Value < NumValues; ++Value)
+	{
+		const float Float = Floats[Value];
+		// NaN fails both comparisons and ends up black
+		const float Clamped = Float > 0.f ? FMath::Min(Float, 1.f) : 0.f;
+		const float Tonemapped = TonemapHdr(Float);
+		HalfToUnorm8[0][Value] = ToGammaSpaceFromLinear(Clamped, false);
+		HalfToUnorm8[1][Value] = ToGammaSpaceFromLinear(Tonemapped, false);
+		HalfToUnorm16[0][Value] = uint16(FMath::RoundToInt(Clamped * MAX_uint16));
+		HalfToUnorm16[1][Value] = uint16(FMath::RoundToInt(Tonemapped * MAX_uint16));
+		Floats[Value] = 1.f - Float;
+	}
+	FloatToHalf(Floats.GetData(), NumValues, HalfInvert);
+}
+
+const FWideColorTables& FWideColorTables::Get()
+{
+	static const FWideColorTables Tables;
+	return Tables;
+}
+
+namespace
+{
+/** How consecutive samples of a channel are laid out in memory */
+enum class ESampleLayout : uint8
+{
+	/** Same sample for every pixel, used by fill channels */
+	Fill,
+	/** Tightly packed plane */
+	Contiguous,
+	/** One channel of four channel pixels */
+	Pixel4,
+	/** Any other distance between samples */
+	Strided,
+	Num
+};
+
+/** Conversion applied to every sample */
+enum class EChannelOp : uint8
+{
+	Copy,
+	/** Bitwise not, which inverts unorm samples of the same type */
+	Invert,
+	/** Any other conversion, through a table indexed by source sample */
+	Lookup,
+	/** Lookup followed by bitwise not of the unorm result */
+	LookupInvert,
+	Num
+};
+
+/** Storage of one sample, halves are kept as raw bits */
+template <ESampleType Type>
+using TSample = typename TChooseClass<Type == ESampleType::U8, uint8, uint16>::Result;
+
+template <ESampleType SrcType, ESampleType DstType, EChannelOp Op>
+FORCEINLINE TSample<DstType> ConvertSample(const uint8* Src, const void* RESTRICT Table)
+{
+	TSample<SrcType> Value;
+	FMemory::Memcpy(&Value, Src, sizeof(Value));
+
+	if constexpr (Op == EChannelOp::Copy)
+	{
+		return TSample<DstType>(Value);
+	}
+	else if constexpr (Op == EChannelOp::Invert)
+	{
+		return TSample<DstType>(~Value);
+	}
+	else
+	{
+		const TSample<DstType> Converted = static_cast<const TSample<DstType>*>(Table)[Value];
+		return Op == EChannelOp::LookupInvert ? TSample<DstType>(~Converted) : Converted;
+	}
+}
+
+template <ESampleType SrcType, ESampleType DstType, ESampleLayout Layout, EChannelOp Op>
+void ConvertKernel(const uint8* RESTRICT Src,
+				   const int32 Stride,
+				   const void* RESTRICT Table,
+				   const int64 Num,
+				   uint8* RESTRICT DstBytes)
+{
+	using FDstSample = TSample<DstType>;
+	FDstSample* RESTRICT Dst = reinterpret_cast<FDstSample*>(DstBytes);
+
+	if constexpr (Layout == ESampleLayout::Fill)
+	{
+		const FDstSample Value = ConvertSample<SrcType, DstType, Op>(Src, Table);
+		if constexpr (sizeof(FDstSample) == 1)
+		{
+			FMemory::Memset(Dst, Value, Num);
+		}
+		else
+		{
+			for (int64 PixelIdx = 0; PixelIdx < Num; ++PixelIdx)
+			{
+				Dst[PixelIdx] = Value;
+			}
+		}
+	}
+	else if constexpr (Layout == ESampleLayout::Contiguous && SrcType == DstType && Op == EChannelOp::Copy)
+	{
+		FMemory::Memcpy(Dst, Src, Num * sizeof(FDstSample));
+	}
+	else
+	{
+		// Step is a constant for every layout but Strided, which lets the compiler vectorize copy and invert loops
+		constexpr int64 SampleSize = sizeof(TSample<SrcType>);
+		const int64 Step = Layout == ESampleLayout::Contiguous ? SampleSize
+						   : Layout == ESampleLayout::Pixel4 ? SampleSize * 4
+															 : int64(Stride);
+		for (int64 PixelIdx = 0; PixelIdx < Num; ++PixelIdx)
+		{
+			Dst[PixelIdx] = ConvertSample<SrcType, DstType, Op>(Src + PixelIdx * Step, Table);
+		}
+	}
+}
+
+template <ESampleType SrcType, ESampleType DstType, ESampleLayout Layout>
+constexpr FConvertKernel LayoutKernels[int32(EChannelOp::Num)] = {
+	&ConvertKernel<SrcType, DstType, Layout, EChannelOp::Copy>,
+	&ConvertKernel<SrcType, DstType, Layout, EChannelOp::Invert>,
+	&ConvertKernel<SrcType, DstType, Layout, EChannelOp::Lookup>,
+	&ConvertKernel<SrcType, DstType, Layout, EChannelOp::LookupInvert>,
+};
+
+/** Dispatch table of every specialization for a pair of sample types, indexed by [ESampleLayout][EChannelOp] */
+template <ESampleType SrcType, ESampleType DstType>
+constexpr const FConvertKernel* ConvertKernels[int32(ESampleLayout::Num)] = {
+	LayoutKernels<SrcType, DstType, ESampleLayout::Fill>,
+	LayoutKernels<SrcType, DstType, ESampleLayout::Contiguous>,
+	LayoutKernels<SrcType, DstType, ESampleLayout::Pixel4>,
+	LayoutKernels<SrcType, DstType, ESampleLayout::Strided>,
+};
+
+template <ESampleType SrcType>
+const FConvertKernel* GetConvertKernels(const ESampleType DstType)
+{
+	switch (DstType)
+	{
+		case ESampleType::U16:
+			return ConvertKernels<SrcType, ESampleType::U16>;
+		case ESampleType::F16:
+			return ConvertKernels<SrcType, ESampleType::F16>;
+		default:
+			return ConvertKernels<SrcType, ESampleType::U8>;
+	}
+}
+
+const FConvertKernel* GetConvertKernels(const ESampleType SrcType, const ESampleType DstType)
+{
+	switch (SrcType)
+	{
+		case ESampleType::U16:
+			return GetConvertKernels<ESampleType::U16>(DstType);
+		case ESampleType::F16:
+			return GetConvertKernels<ESampleType::F16>(DstType);
+		default:
+			return GetConvertKernels<ESampleType::U8>(DstType);
+	}
+}
+
+/** Operation and table turning samples of given source into DstType samples */
+struct FConversion
+{
+	EChannelOp Op = EChannelOp::Copy;
+	const void* Table = nullptr;
+};
+
+FConversion SelectConversion(const FChannelSource& Source, const ESampleType DstType)
+{
+	const bool bInvert = Source.bInvert;
+	const EChannelOp LookupOp = bInvert ? EChannelOp::LookupInvert : EChannelOp::Lookup;
+
+	if (Source.SampleType == ESampleType::U8 && DstType == ESampleType::U8)
+	{
+		const EChannelOp Op = Source.bConvertSRGB ? EChannelOp::Lookup
+							  : bInvert			  ? EChannelOp::Invert
+												  : EChannelOp::Copy;
+		return {Op, FColorTables::Get().GetChannelTable(Source.bConvertSRGB, bInvert)};
+	}
+	if (Source.SampleType == ESampleType::U16 && DstType == ESampleType::U8)
+	{
+		return {LookupOp, FColorTables::Get().Unorm16To8};
+	}
+
+	// Halves can't be inverted bitwise, so their tables already include the invert
+	const FWideColorTables& Tables = FWideColorTables::Get();
+	switch (Source.SampleType)
+	{
+		case ESampleType::U8:
+			if (DstType == ESampleType::U16)
+			{
+				return {LookupOp, Source.bConvertSRGB ? Tables.SRGBToLinear16 : Tables.Unorm8To16};
+			}
+			return {EChannelOp::Lookup, Tables.Unorm8ToHalf[Source.bConvertSRGB][bInvert]};
+		case ESampleType::U16:
+			if (DstType == ESampleType::U16)
+			{
+				return {bInvert ? EChannelOp::Invert : EChannelOp::Copy, nullptr};
+			}
+			return {EChannelOp::Lookup, Tables.Unorm16ToHalf[bInvert]};
+		case ESampleType::F16:
+			if (DstType == ESampleType::U8)
+			{
+				return {LookupOp, Tables.HalfToUnorm8[Source.bTonemapHdr]};
+			}
+			if (DstType == ESampleType::U16)
+			{
+				return {LookupOp, Tables.HalfToUnorm16[Source.bTonemapHdr]};
+			}
+			return bInvert ? FConversion{EChannelOp::Lookup, Tables.HalfInvert} : FConversion{};
+	}
+	return {};
+}
+}  // namespace
+
+FChannelConverter SelectChannelConverter(const FChannelSource& Source, const ESampleType DstType)
+{
+	const int32 SampleSize = GetSampleSize(Source.SampleType);
+
+	ESampleLayout Layout = ESampleLayout::Strided;
+	if (Source.Stride == 0)
+	{
+		Layout = ESampleLayout::Fill;
+	}
+	else if (Source.Stride == SampleSize)
+	{
+		Layout = ESampleLayout::Contiguous;
+	}
+	else if (Source.Stride == SampleSize * 4)
+	{
+		Layout = ESampleLayout::Pixel4;
+	}
+
+	const FConversion Conversion = SelectConversion(Source, DstType);
+
+	FChannelConverter Converter;
+	Converter.Stride = Source.Stride;
+	Converter.Kernel = GetConvertKernels(Source.SampleType, DstType)[int32(Layout)][int32(Conversion.Op)];
+	Converter.Table = Conversion.Table;
+	return Converter;
+}
+
+void HalfToFloat(const uint16* Src, const int64 Num, float* Dst)
+{
+	int64 Idx = 0;
+
+#if TEXTUREPACKER_F16C
+	for (; Idx + 8 <= Num; Idx += 8)
+	{
+		const __m128i Halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Idx));
+		_mm256_storeu_ps(Dst + Idx, _mm256_cvtph_ps(Halves));
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	for (; Idx + 4 <= Num; Idx += 4)
+	{
+		vst1q_f32(Dst + Idx, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Src + Idx))));
+	}
+#endif
+
+	for (; Idx < Num; ++Idx)
+	{
+		FFloat16 Half;
+		Half.Encoded = Src[Idx];
+		Dst[Idx] = Half.GetFloat();
+	}
+}
+
+void FloatToHalf(const float* Src, const int64 Num, uint16* Dst)
+{
+	int64 Idx = 0;
+
+#if TEXTUREPACKER_F16C
+	for (; Idx + 8 <= Num; Idx += 8)
+	{
+		const __m128i Halves = _mm256_cvtps_ph(_mm256_loadu_ps(Src + Idx), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + Idx), Halves);
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	for (; Idx + 4 <= Num; Idx += 4)
+	{
+		vst1_u16(Dst + Idx, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(Src + Idx))));
+	}
+#endif
+
+	for (; Idx < Num; ++Idx)
+	{
+		Dst[Idx] = FFloat16(Src[Idx]).Encoded;
+	}
+}
+
+void InterleaveBGRA8(const uint8* B, const uint8* G, const uint8* R, const uint8* A, const int64 Num, uint8* Dst)
+{
+	int64 PixelIdx = 0;
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+#if PLATFORM_ALWAYS_HAS_AVX_2
+	for (; PixelIdx + 32 <= Num; PixelIdx += 32)
+	{
+		const __m256i VB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B + PixelIdx));
+		const __m256i VG = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(G + PixelIdx));
+		const __m256i VR = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(R + PixelIdx));
+		const __m256i VA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(A + PixelIdx));
+
+		// Unpacks work per 128 bit lane, so the low lane holds pixels 0-15 and the high lane pixels 16-31
+		const __m256i BGLo = _mm256_unpacklo_epi8(VB, VG);
+		const __m256i BGHi = _mm256_unpackhi_epi8(VB, VG);
+		const __m256i RALo = _mm256_unpacklo_epi8(VR, VA);
+		const __m256i RAHi = _mm256_unpackhi_epi8(VR, VA);
+
+		const __m256i P0 = _mm256_unpacklo_epi16(BGLo, RALo);  // 0-3, 16-19
+		const __m256i P1 = _mm256_unpackhi_epi16(BGLo, RALo);  // 4-7, 20-23
+		const __m256i P2 = _mm256_unpacklo_epi16(BGHi, RAHi);  // 8-11, 24-27
+		const __m256i P3 = _mm256_unpackhi_epi16(BGHi, RAHi);  // 12-15, 28-31
+
+		__m256i* Out = reinterpret_cast<__m256i*>(Dst + PixelIdx * 4);
+		_mm256_storeu_si256(Out + 0, _mm256_permute2x128_si256(P0, P1, 0x20));
+		_mm256_storeu_si256(Out + 1, _mm256_permute2x128_si256(P2, P3, 0x20));
+		_mm256_storeu_si256(Out + 2, _mm256_permute2x128_si256(P0, P1, 0x31));
+		_mm256_storeu_si256(Out + 3, _mm256_permute2x128_si256(P2, P3, 0x31));
+	}
+#endif
+	for (; PixelIdx + 16 <= Num; PixelIdx += 16)
+	{
+		const __m128i VB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(B + PixelIdx));
+		const __m128i VG = _mm_loadu_si128(reinterpret_cast<const __m128i*>(G + PixelIdx));
+		const __m128i VR = _mm_loadu_si128(reinterpret_cast<const __m128i*>(R + PixelIdx));
+		const __m128i VA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + PixelIdx));
+
+		const __m128i BGLo = _mm_unpacklo_epi8(VB, VG);
+		const __m128i BGHi = _mm_unpackhi_epi8(VB, VG);
+		const __m128i RALo = _mm_unpacklo_epi8(VR, VA);
+		const __m128i RAHi = _mm_unpackhi_epi8(VR, VA);
+
+		__m128i* Out = reinterpret_cast<__m128i*>(Dst + PixelIdx * 4);
+		_mm_storeu_si128(Out + 0, _mm_unpacklo_epi16(BGLo, RALo));
+		_mm_storeu_si128(Out + 1, _mm_unpackhi_epi16(BGLo, RALo));
+		_mm_storeu_si128(Out + 2, _mm_unpacklo_epi16(BGHi, RAHi));
+		_mm_storeu_si128(Out + 3, _mm_unpackhi_epi16(BGHi, RAHi));
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	for (; PixelIdx + 16 <= Num; PixelIdx += 16)
+	{
+		uint8x16x4_t Pixels;
+		Pixels.val[0] = vld1q_u8(B + PixelIdx);
+		Pixels.val[1] = vld1q_u8(G + PixelIdx);
+		Pixels.val[2] = vld1q_u8(R + PixelIdx);
+		Pixels.val[3] = vld1q_u8(A + PixelIdx);
+		vst4q_u8(Dst + PixelIdx * 4, Pixels);
+	}
+#endif
+
+	for (; PixelIdx < Num; ++PixelIdx)
+	{
+		uint8* Pixel = Dst + PixelIdx * 4;
+		Pixel[0] = B[PixelIdx];
+		Pixel[1] = G[PixelIdx];
+		Pixel[2] = R[PixelIdx];
+		Pixel[3] = A[PixelIdx];
+	}
+}
+
+void InterleaveRGBA16(const uint16* R, const uint16* G, const uint16* B, const uint16* A, const int64 Num, uint16* Dst)
+{
+	int64 PixelIdx = 0;
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+	for (; PixelIdx + 8 <= Num; PixelIdx += 8)
+	{
+		const __m128i VR = _mm_loadu_si128(reinterpret_cast<const __m128i*>(R + PixelIdx));
+		const __m128i VG = _mm_loadu_si128(reinterpret_cast<const __m128i*>(G + PixelIdx));
+		const __m128i VB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(B + PixelIdx));
+		const __m128i VA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + PixelIdx));
+
+		const __m128i RGLo = _mm_unpacklo_epi16(VR, VG);
+		const __m128i RGHi = _mm_unpackhi_epi16(VR, VG);
+		const __m128i BALo = _mm_unpacklo_epi16(VB, VA);
+		const __m128i BAHi = _mm_unpackhi_epi16(VB, VA);
+
+		__m128i* Out = reinterpret_cast<__m128i*>(Dst + PixelIdx * 4);
+		_mm_storeu_si128(Out + 0, _mm_unpacklo_epi32(RGLo, BALo));
+		_mm_storeu_si128(Out + 1, _mm_unpackhi_epi32(RGLo, BALo));
+		_mm_storeu_si128(Out + 2, _mm_unpacklo_epi32(RGHi, BAHi));
+		_mm_storeu_si128(Out + 3, _mm_unpackhi_epi32(RGHi, BAHi));
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	for (; PixelIdx + 8 <= Num; PixelIdx += 8)
+	{
+		uint16x8x4_t Pixels;
+		Pixels.val[0] = vld1q_u16(R + PixelIdx);
+		Pixels.val[1] = vld1q_u16(G + PixelIdx);
+		Pixels.val[2] = vld1q_u16(B + PixelIdx);
+		Pixels.val[3] = vld1q_u16(A + PixelIdx);
+		vst4q_u16(Dst + PixelIdx * 4, Pixels);
+	}
+#endif
+
+	for (; PixelIdx < Num; ++PixelIdx)
+	{
+		uint16* Pixel = Dst + PixelIdx * 4;
+		Pixel[0] = R[PixelIdx];
+		Pixel[1] = G[PixelIdx];
+		Pixel[2] = B[PixelIdx];
+		Pixel[3] = A[PixelIdx];
+	}
+}
+
+void ScatterChannel(const uint8* Plane, const int64 Num, uint8* Dst, const int32 DstStride)
+{
+	for (int64 PixelIdx = 0; PixelIdx < Num; ++PixelIdx)
+	{
+		Dst[PixelIdx * DstStride] = Plane[PixelIdx];
+	}
+}
+
+void ScatterChannel(const uint16* Plane, const int64 Num, uint16* Dst, const int32 DstStride)
+{
+	for (int64 PixelIdx = 0; PixelIdx < Num; ++PixelIdx)
+	{
+		Dst[PixelIdx * DstStride] = Plane[PixelIdx];
+	}
+}
+
+int32 GetNumBandWorkers(const int32 NumRows)
+{
+	const UTexturePackerSettings* Settings = GetDefault<UTexturePackerSettings>();
+	const int32 NumBands = FMath::DivideAndRoundUp(NumRows, FMath::Max(1, Settings->RowsPerBand));
+
+	int32 NumWorkers = FMath::Min(NumBands, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+	if (Settings->MaxWorkerThreads > 0)
+	{
+		NumWorkers = FMath::Min(NumWorkers, Settings->MaxWorkerThreads);
+	}
+	return FMath::Max(1, NumWorkers);
+}
+
+void ParallelForRowBands(const int32 NumRows, TFunctionRef<void(int32 RowStart, int32 RowEnd)> Body)
+{
+	const int32 RowsPerBand = FMath::Max(1, GetDefault<UTexturePackerSettings>()->RowsPerBand);
+	const int32 NumBands = FMath::DivideAndRoundUp(NumRows, RowsPerBand);
+	const int32 NumWorkers = GetNumBandWorkers(NumRows);
+
+	// One task per allowed worker, each one takes every NumWorkers-th band so the cap is never exceeded
+	ParallelFor(
+		NumWorkers,
+		[&](const int32 WorkerIdx)
+		{
+			for (int32 Band = WorkerIdx; Band < NumBands; Band += NumWorkers)
+			{
+				const int32 RowStart = Band * RowsPerBand;
+				Body(RowStart, FMath::Min(NumRows, RowStart + RowsPerBand));
+			}
+		},
+		NumWorkers > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+}  // namespace TexturePacker
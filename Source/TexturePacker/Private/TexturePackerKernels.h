@@ -0,0 +1,208 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TexturePacker
+{
+extern const float sRGBToLinearTable[256];
+
+/** Type of a single channel sample in source data, planes and packed pixels */
+enum class ESampleType : uint8
+{
+	U8,
+	U16,
+	F16,
+};
+
+constexpr int32 GetSampleSize(const ESampleType SampleType)
+{
+	return SampleType == ESampleType::U8 ? 1 : 2;
+}
+
+uint8 ToGammaSpaceFromLinear(const float In, const bool bSRGB);
+
+/**
+ * @brief Byte conversion tables shared by every pack
+ *
+ * Built once on first use from the float reference conversions, so pixel loops never touch floats.
+ */
+struct FColorTables
+{
+	static constexpr int32 LinearToSRGBSize = 4096;
+
+	uint8 Identity[256];
+	uint8 Invert[256];
+	uint8 SRGBToLinear[256];
+	uint8 SRGBToLinearInverted[256];
+	/** Linear value quantized to 12 bits to 8 bit sRGB */
+	uint8 LinearToSRGB[LinearToSRGBSize];
+	/** 16 bit unorm to 8 bit unorm */
+	uint8 Unorm16To8[65536];
+
+	static const FColorTables& Get();
+
+	/** 8 bit table fusing all conversions of given channel */
+	const uint8* GetChannelTable(const bool bConvertSRGB, const bool bInvert) const;
+
+	/** Linear float to 8 bit sRGB through LinearToSRGB */
+	FORCEINLINE uint8 EncodeSRGB(const float Linear) const
+	{
+		return LinearToSRGB[FMath::TruncToInt(FMath::Clamp(Linear, 0.f, 1.f) * (LinearToSRGBSize - 1) + 0.5f)];
+	}
+
+private:
+	FColorTables();
+};
+
+/**
+ * @brief Conversion tables for 16 bit and half float samples
+ *
+ * Kept apart from FColorTables, they take about 770 KB and are only built by the first Get, once a pack reads or
+ * writes wide samples. Half floats are stored as their raw bits.
+ */
+struct FWideColorTables
+{
+	/** 8 bit unorm to 16 bit unorm */
+	uint16 Unorm8To16[256];
+	/** 8 bit sRGB to 16 bit linear unorm */
+	uint16 SRGBToLinear16[256];
+	/** 8 bit sample to linear half, indexed by [bConvertSRGB][bInvert] */
+	uint16 Unorm8ToHalf[2][2][256];
+	/** 16 bit unorm to half, indexed by [bInvert] */
+	uint16 Unorm16ToHalf[2][65536];
+	/** Half clamped or tonemapped to [0, 1] to 8 and 16 bit unorm, indexed by [bTonemap] */
+	uint8 HalfToUnorm8[2][65536];
+	uint16 HalfToUnorm16[2][65536];
+	/** One minus half */
+	uint16 HalfInvert[65536];
+
+	static const FWideColorTables& Get();
+
+private:
+	FWideColorTables();
+};
+
+/**
+ * @brief Describes where one channel lives in decoded source data and how it has to be converted
+ *
+ * All conversion flags are resolved once per channel by SelectChannelConverter, never per pixel.
+ */
+struct FChannelSource
+{
+	/** First byte of the channel for the first pixel */
+	const uint8* Data = nullptr;
+	/** Distance in bytes between the same channel of two neighbouring pixels */
+	int32 Stride = 1;
+	ESampleType SampleType = ESampleType::U8;
+	/** Only applies to 8 bit samples, wider ones are always linear */
+	bool bConvertSRGB = false;
+	bool bInvert = false;
+	/** Half samples written as unorm are tonemapped instead of clamped */
+	bool bTonemapHdr = false;
+};
+
+/** Converts Num samples of one channel into a plane, sample types, layout and conversion are fixed at compile time */
+using FConvertKernel = void (*)(const uint8* Src, const int32 Stride, const void* Table, const int64 Num, uint8* Dst);
+
+/**
+ * @brief Conversion of one channel resolved to a specialized kernel
+ *
+ * Selected once per channel and then run for any number of rows with the same layout.
+ */
+struct FChannelConverter
+{
+	FConvertKernel Kernel = nullptr;
+	/** Lookup table used by the kernel, if any, indexed by source sample and holding destination samples */
+	const void* Table = nullptr;
+	int32 Stride = 1;
+
+	/**
+	 * @brief Convert channel into tightly packed plane of the destination sample type
+	 *
+	 * @param Src First byte of the channel for the first pixel
+	 * @param Num Number of pixels to convert
+	 * @param Dst Destination plane, must hold at least Num samples
+	 */
+	FORCEINLINE void Run(const uint8* Src, const int64 Num, uint8* Dst) const
+	{
+		Kernel(Src, Stride, Table, Num, Dst);
+	}
+};
+
+/**
+ * @brief Pick the kernel specialized for sample types, stride, sRGB conversion and invert of given channel
+ *
+ * Source.Data is not used, so the converter can be selected before the channel data is known. Samples written as
+ * unorm are clamped to [0, 1], halves keep the full range of half sources.
+ *
+ * @param DstType Sample type of the plane the converter writes
+ */
+FChannelConverter SelectChannelConverter(const FChannelSource& Source, const ESampleType DstType = ESampleType::U8);
+
+/**
+ * @brief Convert half floats to floats
+ *
+ * Uses F16C (8 values per iteration) when every supported CPU has it or NEON (4 values per iteration).
+ */
+void HalfToFloat(const uint16* Src, const int64 Num, float* Dst);
+
+/** Convert floats to half floats with round to nearest even, vectorized like HalfToFloat */
+void FloatToHalf(const float* Src, const int64 Num, uint16* Dst);
+
+/** Reinhard tonemap of a linear value into [0, 1], negative values and NaN map to 0 */
+FORCEINLINE float TonemapHdr(const float Linear)
+{
+	return Linear > 0.f ? 1.f - 1.f / (1.f + Linear) : 0.f;
+}
+
+/**
+ * @brief Interleave four 8 bit planes into BGRA8 pixels
+ *
+ * Uses AVX2 (32 pixels per iteration), SSE2 or NEON (16 pixels per iteration) when available.
+ *
+ * @param Num Number of pixels in every plane
+ * @param Dst Destination pixels, must hold at least Num * 4 bytes
+ */
+void InterleaveBGRA8(const uint8* B, const uint8* G, const uint8* R, const uint8* A, const int64 Num, uint8* Dst);
+
+/**
+ * @brief Interleave four 16 bit planes into RGBA16 or RGBA16F pixels
+ *
+ * Samples are moved as they are, so the same kernel serves unorm and half planes. Uses SSE2 or NEON (8 pixels per
+ * iteration) when available.
+ *
+ * @param Num Number of pixels in every plane
+ * @param Dst Destination pixels, must hold at least Num * 4 samples
+ */
+void InterleaveRGBA16(const uint16* R, const uint16* G, const uint16* B, const uint16* A, const int64 Num, uint16* Dst);
+
+/**
+ * @brief Write 8 bit plane into one channel of interleaved pixels
+ *
+ * @param Dst First channel byte of the first destination pixel
+ * @param DstStride Distance in bytes between two destination pixels
+ */
+void ScatterChannel(const uint8* Plane, const int64 Num, uint8* Dst, const int32 DstStride);
+
+/**
+ * @brief Write 16 bit plane into one channel of interleaved pixels
+ *
+ * @param Dst First channel sample of the first destination pixel
+ * @param DstStride Distance in samples between two destination pixels
+ */
+void ScatterChannel(const uint16* Plane, const int64 Num, uint16* Dst, const int32 DstStride);
+
+/**
+ * @brief Split rows into bands and process them in parallel
+ *
+ * Band size and worker count come from UTexturePackerSettings. Bands never overlap, so as long as Body only writes
+ * rows in its band the result is identical to a single threaded run.
+ *
+ * @param NumRows Number of rows to process
+ * @param Body Called with [RowStart, RowEnd) range of every band
+ */
+void ParallelForRowBands(const int32 NumRows, TFunctionRef<void(int32 RowStart, int32 RowEnd)> Body);
+
+/** Number of threads ParallelForRowBands will use for NumRows rows */
+int32 GetNumBandWorkers(const int32 NumRows);
+}  // namespace TexturePacker
@@ -0,0 +1,483 @@
+#include "TexturePackerResize.h"
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "TexturePackerKernels.h"
+#include "TexturePackerSourceCache.h"
+
+namespace TexturePacker
+{
+namespace
+{
+float GetFilterSupport(const ETexturePackerResizeFilter Filter)
+{
+	switch (Filter)
+	{
+		case ETexturePackerResizeFilter::Triangle:
+			return 1.f;
+		case ETexturePackerResizeFilter::Lanczos3:
+			return 3.f;
+		default:
+			return 0.5f;
+	}
+}
+
+float EvaluateFilter(const ETexturePackerResizeFilter Filter, const float X)
+{
+	switch (Filter)
+	{
+		case ETexturePackerResizeFilter::Triangle:
+			return FMath::Max(0.f, 1.f - FMath::Abs(X));
+		case ETexturePackerResizeFilter::Lanczos3:
+		{
+			const float AbsX = FMath::Abs(X);
+			if (AbsX < SMALL_NUMBER)
+			{
+				return 1.f;
+			}
+			if (AbsX >= 3.f)
+			{
+				return 0.f;
+			}
+			const float PiX = PI * X;
+			return 3.f * FMath::Sin(PiX) * FMath::Sin(PiX / 3.f) / (PiX * PiX);
+		}
+		default:
+			return X >= -0.5f && X < 0.5f ? 1.f : 0.f;
+	}
+}
+
+/** Dst += Src * Weight */
+void AccumulateRow(const float* Src, const float Weight, const int32 Num, float* Dst)
+{
+	const VectorRegister4Float VectorWeight = VectorSetFloat1(Weight);
+
+	int32 Idx = 0;
+	for (; Idx + 4 <= Num; Idx += 4)
+	{
+		VectorStore(VectorMultiplyAdd(VectorLoad(Src + Idx), VectorWeight, VectorLoad(Dst + Idx)), Dst + Idx);
+	}
+	for (; Idx < Num; ++Idx)
+	{
+		Dst[Idx] += Src[Idx] * Weight;
+	}
+}
+}  // namespace
+
+void FResampler::FAxisWeights::Build(const int32 SrcSize, const int32 DstSize, const ETexturePackerResizeFilter Filter)
+{
+	const float Scale = DstSize / static_cast<float>(SrcSize);
+	// When downscaling the filter is stretched over the source, so every source pixel contributes
+	const float FilterScale = FMath::Max(1.f, 1.f / Scale);
+	const float Support = GetFilterSupport(Filter) * FilterScale;
+
+	First.SetNumUninitialized(DstSize);
+	Count.SetNumUninitialized(DstSize);
+	Offset.SetNumUninitialized(DstSize);
+	Weights.Reset();
+
+	for (int32 DstIdx = 0; DstIdx < DstSize; ++DstIdx)
+	{
+		const float Center = (DstIdx + 0.5f) / Scale;
+		int32 Start = FMath::Max(0, FMath::FloorToInt(Center - Support));
+		int32 End = FMath::Min(SrcSize - 1, FMath::CeilToInt(Center + Support));
+
+		const int32 WeightOffset = Weights.Num();
+		float Total = 0.f;
+		for (int32 SrcIdx = Start; SrcIdx <= End; ++SrcIdx)
+		{
+			const float Weight = EvaluateFilter(Filter, (SrcIdx + 0.5f - Center) / FilterScale);
+			Weights.Add(Weight);
+			Total += Weight;
+		}
+
+		// Drop taps that do not contribute at both ends
+		int32 NumTaps = End - Start + 1;
+		int32 Skip = 0;
+		while (NumTaps > 1 && Weights[WeightOffset + Skip] == 0.f)
+		{
+			++Skip;
+			--NumTaps;
+		}
+		while (NumTaps > 1 && Weights[WeightOffset + Skip + NumTaps - 1] == 0.f)
+		{
+			--NumTaps;
+		}
+		if (Skip > 0)
+		{
+			for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+			{
+				Weights[WeightOffset + Tap] = Weights[WeightOffset + Skip + Tap];
+			}
+		}
+		Weights.SetNum(WeightOffset + NumTaps, false);
+
+		// Taps clipped at the image border are compensated by normalizing
+		const float InvTotal = Total != 0.f ? 1.f / Total : 0.f;
+		for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+		{
+			Weights[WeightOffset + Tap] *= InvTotal;
+		}
+
+		First[DstIdx] = Start + Skip;
+		Count[DstIdx] = NumTaps;
+		Offset[DstIdx] = WeightOffset;
+	}
+}
+
+void FResampler::FAxisWeights::BuildLanes(const int32 SrcSize)
+{
+	const int32 NumGroups = First.Num() / 4;
+	GroupOffset.SetNumUninitialized(NumGroups);
+	GroupTaps.SetNumUninitialized(NumGroups);
+	LaneWeights.Reset();
+	LaneIndices.Reset();
+
+	for (int32 Group = 0; Group < NumGroups; ++Group)
+	{
+		int32 NumTaps = 0;
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			NumTaps = FMath::Max(NumTaps, Count[Group * 4 + Lane]);
+		}
+
+		GroupOffset[Group] = LaneWeights.Num();
+		GroupTaps[Group] = NumTaps;
+		for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+		{
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				const int32 DstIdx = Group * 4 + Lane;
+				const bool bValid = Tap < Count[DstIdx];
+				LaneWeights.Add(bValid ? Weights[Offset[DstIdx] + Tap] : 0.f);
+				LaneIndices.Add(FMath::Min(First[DstIdx] + Tap, SrcSize - 1));
+			}
+		}
+	}
+}
+
+FResampleFormat FResampleFormat::Channel(const ETextureSourceFormat Format, const int32 ChannelIdx, const bool bSRGB)
+{
+	const FSourceLayout Layout = GetSourceLayout(Format);
+	check(Layout.IsValid());
+
+	FResampleFormat Result;
+	Result.SampleType = Layout.SampleType;
+	Result.DstSampleType = GetPlaneSampleType(Layout, ChannelIdx);
+	Result.NumChannels = 1;
+	Result.SrcStride = Layout.NumChannels * Layout.BytesPerChannel;
+	// Mantissas are linear, the exponent is the last channel of the pixel in both channel orders
+	if (IsSharedExponentChannel(Layout, ChannelIdx))
+	{
+		Result.ExponentOffset = (int32(EChannel::A) - ChannelIdx) * Layout.BytesPerChannel;
+	}
+	Result.SRGBMask = bSRGB && Result.SampleType == ESampleType::U8 && Result.ExponentOffset == 0 ? 1 : 0;
+	return Result;
+}
+
+FResampler::FResampler(const FResampleFormat& InFormat,
+					   const int32 InSrcWidth,
+					   const int32 InSrcHeight,
+					   const int32 InDstWidth,
+					   const int32 InDstHeight,
+					   const ETexturePackerResizeFilter Filter)
+	: Format(InFormat)
+	, DstBytesPerSample(GetSampleSize(InFormat.DstSampleType))
+	, SrcWidth(InSrcWidth)
+	, SrcHeight(InSrcHeight)
+	, DstWidth(InDstWidth)
+	, DstHeight(InDstHeight)
+{
+	check(Format.NumChannels >= 1 && Format.NumChannels <= 4);
+	check(Format.SrcStride >= Format.NumChannels * GetSampleSize(Format.SampleType));
+	check(Format.ExponentOffset == 0 || Format.SampleType == ESampleType::U8);
+	check(Format.ExponentOffset != 0 || Format.DstSampleType == Format.SampleType);
+
+	for (int32 ChannelIdx = 0; ChannelIdx < 4; ++ChannelIdx)
+	{
+		const bool bSRGB = (Format.SRGBMask >> ChannelIdx) & 1;
+		for (int32 Value = 0; Value <= MAX_uint8; ++Value)
+		{
+			DecodeTable[ChannelIdx][Value] = bSRGB ? sRGBToLinearTable[Value] : Value / 255.f;
+		}
+	}
+
+	// Same decoding as FColor::FromRGBE, a zero exponent is black
+	ExponentTable[0] = 0.f;
+	for (int32 Exponent = 1; Exponent <= MAX_uint8; ++Exponent)
+	{
+		ExponentTable[Exponent] = float(FMath::Pow(2.0, Exponent - 128.0) / 255.0);
+	}
+
+	Horizontal.Build(SrcWidth, DstWidth, Filter);
+	Vertical.Build(SrcHeight, DstHeight, Filter);
+	if (Format.NumChannels == 1)
+	{
+		Horizontal.BuildLanes(SrcWidth);
+	}
+}
+
+bool FResampler::CanResize(const ETextureSourceFormat Format)
+{
+	switch (Format)
+	{
+		case TSF_BGRA8:
+		case TSF_BGRE8:
+		case TSF_RGBA8:
+		case TSF_RGBE8:
+		case TSF_G8:
+		case TSF_G16:
+		case TSF_RGBA16:
+		case TSF_RGBA16F:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void FResampler::DecodeRow(const uint8* Src, float* Dst, uint16* HalfRow) const
+{
+	const int32 NumChannels = Format.NumChannels;
+	const int32 Stride = Format.SrcStride;
+
+	switch (Format.SampleType)
+	{
+		case ESampleType::U8:
+			if (Format.ExponentOffset != 0)
+			{
+				// Every mantissa of a pixel is scaled by its shared exponent
+				for (int32 X = 0; X < SrcWidth; ++X)
+				{
+					const uint8* Pixel = Src + X * Stride;
+					const float Scale = ExponentTable[Pixel[Format.ExponentOffset]];
+					for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+					{
+						Dst[X * NumChannels + ChannelIdx] = Pixel[ChannelIdx] * Scale;
+					}
+				}
+				break;
+			}
+			for (int32 X = 0; X < SrcWidth; ++X)
+			{
+				const uint8* Pixel = Src + X * Stride;
+				for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+				{
+					Dst[X * NumChannels + ChannelIdx] = DecodeTable[ChannelIdx][Pixel[ChannelIdx]];
+				}
+			}
+			break;
+		case ESampleType::U16:
+			for (int32 X = 0; X < SrcWidth; ++X)
+			{
+				const uint16* Pixel = reinterpret_cast<const uint16*>(Src + X * Stride);
+				for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+				{
+					Dst[X * NumChannels + ChannelIdx] = Pixel[ChannelIdx] / float(MAX_uint16);
+				}
+			}
+			break;
+		case ESampleType::F16:
+		{
+			// Resized channels are gathered into a compact row first, so the whole row converts in one batch
+			const uint16* Halves = reinterpret_cast<const uint16*>(Src);
+			if (Stride != NumChannels * int32(sizeof(uint16)))
+			{
+				for (int32 X = 0; X < SrcWidth; ++X)
+				{
+					const uint16* Pixel = reinterpret_cast<const uint16*>(Src + X * Stride);
+					for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+					{
+						HalfRow[X * NumChannels + ChannelIdx] = Pixel[ChannelIdx];
+					}
+				}
+				Halves = HalfRow;
+			}
+			HalfToFloat(Halves, int64(SrcWidth) * NumChannels, Dst);
+			break;
+		}
+	}
+}
+
+void FResampler::FilterRow(const float* Src, float* Dst) const
+{
+	const int32 NumChannels = Format.NumChannels;
+
+	if (NumChannels == 4)
+	{
+		// Whole pixel fits a vector register, one multiply add per tap
+		for (int32 X = 0; X < DstWidth; ++X)
+		{
+			const float* Weights = Horizontal.Weights.GetData() + Horizontal.Offset[X];
+			const float* Pixels = Src + Horizontal.First[X] * 4;
+
+			VectorRegister4Float Sum = VectorZeroFloat();
+			for (int32 Tap = 0; Tap < Horizontal.Count[X]; ++Tap)
+			{
+				Sum = VectorMultiplyAdd(VectorLoad(Pixels + Tap * 4), VectorSetFloat1(Weights[Tap]), Sum);
+			}
+			VectorStore(Sum, Dst + X * 4);
+		}
+		return;
+	}
+
+	int32 FirstScalar = 0;
+	if (NumChannels == 1)
+	{
+		// Four destination pixels per vector, their source taps are gathered lane by lane
+		for (int32 Group = 0; Group < Horizontal.GroupTaps.Num(); ++Group)
+		{
+			const float* Weights = Horizontal.LaneWeights.GetData() + Horizontal.GroupOffset[Group];
+			const int32* Indices = Horizontal.LaneIndices.GetData() + Horizontal.GroupOffset[Group];
+
+			VectorRegister4Float Sum = VectorZeroFloat();
+			for (int32 Tap = 0; Tap < Horizontal.GroupTaps[Group]; ++Tap, Weights += 4, Indices += 4)
+			{
+				const VectorRegister4Float Samples =
+					MakeVectorRegister(Src[Indices[0]], Src[Indices[1]], Src[Indices[2]], Src[Indices[3]]);
+				Sum = VectorMultiplyAdd(Samples, VectorLoad(Weights), Sum);
+			}
+			VectorStore(Sum, Dst + Group * 4);
+		}
+		FirstScalar = Horizontal.GroupTaps.Num() * 4;
+	}
+
+	for (int32 X = FirstScalar; X < DstWidth; ++X)
+	{
+		const float* Weights = Horizontal.Weights.GetData() + Horizontal.Offset[X];
+		const float* Pixels = Src + Horizontal.First[X] * NumChannels;
+
+		for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+		{
+			float Sum = 0.f;
+			for (int32 Tap = 0; Tap < Horizontal.Count[X]; ++Tap)
+			{
+				Sum += Pixels[Tap * NumChannels + ChannelIdx] * Weights[Tap];
+			}
+			Dst[X * NumChannels + ChannelIdx] = Sum;
+		}
+	}
+}
+
+void FResampler::EncodeRow(const float* Src, uint8* Dst) const
+{
+	const int32 NumChannels = Format.NumChannels;
+	const int32 NumSamples = DstWidth * NumChannels;
+
+	switch (Format.DstSampleType)
+	{
+		case ESampleType::U8:
+		{
+			const FColorTables& Tables = FColorTables::Get();
+			for (int32 SampleIdx = 0; SampleIdx < NumSamples; SampleIdx += NumChannels)
+			{
+				for (int32 ChannelIdx = 0; ChannelIdx < NumChannels; ++ChannelIdx)
+				{
+					const float Linear = Src[SampleIdx + ChannelIdx];
+					Dst[SampleIdx + ChannelIdx] = (Format.SRGBMask >> ChannelIdx) & 1
+													  ? Tables.EncodeSRGB(Linear)
+													  : ToGammaSpaceFromLinear(Linear, false);
+				}
+			}
+			break;
+		}
+		case ESampleType::U16:
+		{
+			uint16* Samples = reinterpret_cast<uint16*>(Dst);
+			for (int32 SampleIdx = 0; SampleIdx < NumSamples; ++SampleIdx)
+			{
+				Samples[SampleIdx] =
+					uint16(FMath::RoundToInt(FMath::Clamp(Src[SampleIdx], 0.f, 1.f) * float(MAX_uint16)));
+			}
+			break;
+		}
+		case ESampleType::F16:
+			FloatToHalf(Src, NumSamples, reinterpret_cast<uint16*>(Dst));
+			break;
+	}
+}
+
+void FResampler::ResizeRows(const uint8* Src, const int32 RowStart, const int32 RowEnd, uint8* DstRows) const
+{
+	check(RowStart >= 0 && RowStart <= RowEnd && RowEnd <= DstHeight);
+	if (RowStart == RowEnd)
+	{
+		return;
+	}
+
+	// Source rows under the vertical footprint of all destination rows in the range
+	const int32 SrcRowFirst = Vertical.First[RowStart];
+	int32 SrcRowEnd = SrcRowFirst;
+	for (int32 Y = RowStart; Y < RowEnd; ++Y)
+	{
+		SrcRowEnd = FMath::Max(SrcRowEnd, Vertical.First[Y] + Vertical.Count[Y]);
+	}
+
+	const int32 RowSamples = DstWidth * Format.NumChannels;
+	const int64 SrcRowBytes = int64(SrcWidth) * Format.SrcStride;
+	const int64 DstRowBytes = int64(RowSamples) * DstBytesPerSample;
+
+	TArray<float> DecodedRow;
+	DecodedRow.SetNumUninitialized(SrcWidth * Format.NumChannels);
+	TArray<uint16> HalfRow;
+	HalfRow.SetNumUninitialized(Format.SampleType == ESampleType::F16 ? SrcWidth * Format.NumChannels : 0);
+
+	TArray64<float> FilteredRows;
+	FilteredRows.SetNumUninitialized(int64(SrcRowEnd - SrcRowFirst) * RowSamples);
+	for (int32 SrcY = SrcRowFirst; SrcY < SrcRowEnd; ++SrcY)
+	{
+		DecodeRow(Src + SrcY * SrcRowBytes, DecodedRow.GetData(), HalfRow.GetData());
+		FilterRow(DecodedRow.GetData(), FilteredRows.GetData() + int64(SrcY - SrcRowFirst) * RowSamples);
+	}
+
+	TArray<float> BlendedRow;
+	BlendedRow.SetNumUninitialized(RowSamples);
+	for (int32 Y = RowStart; Y < RowEnd; ++Y)
+	{
+		FMemory::Memzero(BlendedRow.GetData(), RowSamples * sizeof(float));
+
+		const float* Weights = Vertical.Weights.GetData() + Vertical.Offset[Y];
+		for (int32 Tap = 0; Tap < Vertical.Count[Y]; ++Tap)
+		{
+			const float* FilteredRow = FilteredRows.GetData() + int64(Vertical.First[Y] + Tap - SrcRowFirst) * RowSamples;
+			AccumulateRow(FilteredRow, Weights[Tap], RowSamples, BlendedRow.GetData());
+		}
+
+		EncodeRow(BlendedRow.GetData(), DstRows + (Y - RowStart) * DstRowBytes);
+	}
+}
+
+void GenerateMipChain(const ETextureSourceFormat Format,
+					  const uint32 SRGBMask,
+					  const int32 SizeX,
+					  const int32 SizeY,
+					  TArrayView<uint8* const> Mips)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::GenerateMipChain);
+
+	// Whole pixels are filtered at once, four channel formats take the vectorized filter path
+	const FSourceLayout Layout = GetSourceLayout(Format);
+	check(Layout.IsValid());
+	FResampleFormat MipFormat;
+	MipFormat.SampleType = Layout.SampleType;
+	MipFormat.DstSampleType = Layout.SampleType;
+	MipFormat.NumChannels = Layout.NumChannels;
+	MipFormat.SrcStride = Layout.NumChannels * Layout.BytesPerChannel;
+	MipFormat.SRGBMask = Layout.SampleType == ESampleType::U8 ? SRGBMask : 0;
+
+	for (int32 MipIndex = 1; MipIndex < Mips.Num(); ++MipIndex)
+	{
+		const int32 DstSizeX = FMath::Max(1, SizeX >> MipIndex);
+		const int32 DstSizeY = FMath::Max(1, SizeY >> MipIndex);
+		const FResampler Resampler(MipFormat,
+								   FMath::Max(1, SizeX >> (MipIndex - 1)),
+								   FMath::Max(1, SizeY >> (MipIndex - 1)),
+								   DstSizeX,
+								   DstSizeY,
+								   ETexturePackerResizeFilter::Box);
+
+		const int64 DstRowBytes = int64(DstSizeX) * MipFormat.SrcStride;
+		auto ResizeRows = [&](const int32 RowStart, const int32 RowEnd)
+		{ Resampler.ResizeRows(Mips[MipIndex - 1], RowStart, RowEnd, Mips[MipIndex] + RowStart * DstRowBytes); };
+		ParallelForRowBands(DstSizeY, ResizeRows);
+	}
+}
+}  // namespace TexturePacker
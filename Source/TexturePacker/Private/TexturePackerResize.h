@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+#include "TexturePackerKernels.h"
+#include "TexturePackerSettings.h"
+
+namespace TexturePacker
+{
+/** Layout of the samples a FResampler reads and writes */
+struct FResampleFormat
+{
+	ESampleType SampleType = ESampleType::U8;
+	/** Type of resized samples, differs from SampleType only for shared exponent mantissas which resize to halves */
+	ESampleType DstSampleType = ESampleType::U8;
+	/** Channels resized per pixel, read from the start of every source pixel. Destination pixels are tightly packed */
+	int32 NumChannels = 1;
+	/** Distance in bytes between two source pixels */
+	int32 SrcStride = 1;
+	/** Bit per channel that is stored in sRGB, only used for 8 bit samples */
+	uint32 SRGBMask = 0;
+	/** Distance in bytes from the first resized channel to the shared exponent of the pixel, 0 when there is none */
+	int32 ExponentOffset = 0;
+
+	/**
+	 * @brief Single channel of given source format
+	 *
+	 * Point the source data at the channel, every other channel of the pixel is skipped.
+	 *
+	 * @param ChannelIdx Index of the channel among the channels of a source pixel
+	 */
+	static FResampleFormat Channel(const ETextureSourceFormat Format, const int32 ChannelIdx, const bool bSRGB);
+};
+
+/**
+ * @brief Separable resampler for raw source data
+ *
+ * Filter weights for both axes are computed once on construction. Every call to ResizeRows filters the source rows
+ * under its destination rows horizontally and then blends them vertically, so the cost is linear in the number of
+ * source pixels for any scale factor. Filtering is done in linear space, sRGB channels are decoded and encoded back.
+ * Every source format is read through its stride, so a channel is resized straight from the interleaved pixels.
+ */
+class FResampler
+{
+public:
+	FResampler(const FResampleFormat& InFormat,
+			   const int32 SrcWidth,
+			   const int32 SrcHeight,
+			   const int32 DstWidth,
+			   const int32 DstHeight,
+			   const ETexturePackerResizeFilter Filter);
+
+	/** Whether FResampler supports given source format */
+	static bool CanResize(const ETextureSourceFormat Format);
+
+	/**
+	 * @brief Resize rows [RowStart, RowEnd) of the destination
+	 *
+	 * Safe to call concurrently for different row ranges. Every destination row only depends on its own index, so
+	 * any split into row ranges produces the same image.
+	 *
+	 * @param Src First resized channel of the first pixel of the whole source image
+	 * @param RowStart First destination row that will be written
+	 * @param RowEnd One past the last destination row that will be written
+	 * @param DstRows Resized rows, first byte is the first pixel of RowStart
+	 */
+	void ResizeRows(const uint8* Src, const int32 RowStart, const int32 RowEnd, uint8* DstRows) const;
+
+private:
+	/** Source taps and their normalized weights for every destination coordinate of one axis */
+	struct FAxisWeights
+	{
+		TArray<int32> First;
+		TArray<int32> Count;
+		TArray<int32> Offset;
+		TArray<float> Weights;
+
+		/**
+		 * Taps of every four consecutive destination coordinates interleaved, so single channel rows filter four
+		 * pixels per vector. Coordinates with fewer taps than their group get zero weights on valid source indices.
+		 */
+		TArray<float> LaneWeights;
+		TArray<int32> LaneIndices;
+		/** First lane tap and taps of every full group of four coordinates, only built for single channel rows */
+		TArray<int32> GroupOffset;
+		TArray<int32> GroupTaps;
+
+		void Build(const int32 SrcSize, const int32 DstSize, const ETexturePackerResizeFilter Filter);
+
+		void BuildLanes(const int32 SrcSize);
+	};
+
+	/** @param HalfRow Scratch row of SrcWidth * NumChannels samples, used to gather strided half samples */
+	void DecodeRow(const uint8* Src, float* Dst, uint16* HalfRow) const;
+	void FilterRow(const float* Src, float* Dst) const;
+	void EncodeRow(const float* Src, uint8* Dst) const;
+
+	FResampleFormat Format;
+	int32 DstBytesPerSample = 1;
+
+	int32 SrcWidth;
+	int32 SrcHeight;
+	int32 DstWidth;
+	int32 DstHeight;
+
+	FAxisWeights Horizontal;
+	FAxisWeights Vertical;
+
+	/** 8 bit to linear float, per channel */
+	float DecodeTable[4][256];
+	/** Shared exponent to the scale of its mantissas */
+	float ExponentTable[256];
+};
+
+/**
+ * @brief Fill every mip after the first of a source mip chain
+ *
+ * Each mip is box filtered from the previous one in linear space, rows of a mip are filtered in parallel.
+ *
+ * @param SRGBMask Bit per channel of a source pixel that is stored in sRGB, only used for 8 bit formats
+ * @param Mips Pixels of every mip in the chain, the first one already written
+ */
+void GenerateMipChain(const ETextureSourceFormat Format,
+					  const uint32 SRGBMask,
+					  const int32 SizeX,
+					  const int32 SizeY,
+					  TArrayView<uint8* const> Mips);
+}  // namespace TexturePacker
@@ -0,0 +1,267 @@
+#include "TexturePackerSave.h"
+
+#include "Engine/Texture.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlOperation.h"
+#include "ISourceControlProvider.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "SourceControlOperations.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTexturePackerSave, Log, All);
+
+namespace TexturePacker
+{
+namespace
+{
+class FEditorPackSourceControl final : public IPackSourceControl
+{
+public:
+	virtual bool IsEnabled() const override
+	{
+		return ISourceControlModule::Get().IsEnabled() && GetProvider().IsAvailable();
+	}
+
+	virtual void QueryFiles(const TArray<FString>& Files,
+							TArray<FString>& OutCheckOut,
+							TArray<FString>& OutAdd) override
+	{
+		ISourceControlProvider& Provider = GetProvider();
+
+		// One status request refreshes every file, states are then read from the provider cache
+		++NumRequests;
+		Provider.Execute(ISourceControlOperation::Create<FUpdateStatus>(), Files);
+
+		TArray<FSourceControlStateRef> States;
+		Provider.GetState(Files, States, EStateCacheUsage::Use);
+		for (const FSourceControlStateRef& State : States)
+		{
+			if (State->IsCheckedOutOther())
+			{
+				UE_LOG(LogTexturePackerSave, Warning, TEXT("%s is checked out by someone else"), *State->GetFilename());
+			}
+
+			if (!State->IsSourceControlled())
+			{
+				OutAdd.Add(State->GetFilename());
+			}
+			else if (State->CanCheckout())
+			{
+				OutCheckOut.Add(State->GetFilename());
+			}
+		}
+	}
+
+	virtual bool CheckOut(const TArray<FString>& Files) override
+	{
+		++NumRequests;
+		return GetProvider().Execute(ISourceControlOperation::Create<FCheckOut>(), Files) == ECommandResult::Succeeded;
+	}
+
+	virtual bool MarkForAdd(const TArray<FString>& Files) override
+	{
+		++NumRequests;
+		return GetProvider().Execute(ISourceControlOperation::Create<FMarkForAdd>(), Files)
+			   == ECommandResult::Succeeded;
+	}
+
+	virtual int32 GetNumRequests() const override
+	{
+		return NumRequests;
+	}
+
+private:
+	static ISourceControlProvider& GetProvider()
+	{
+		return ISourceControlModule::Get().GetProvider();
+	}
+
+	int32 NumRequests = 0;
+};
+}  // namespace
+
+TUniquePtr<IPackSourceControl> MakeEditorSourceControl()
+{
+	return MakeUnique<FEditorPackSourceControl>();
+}
+
+void FFakePackSourceControl::QueryFiles(const TArray<FString>& Files,
+										TArray<FString>& OutCheckOut,
+										TArray<FString>& OutAdd)
+{
+	++NumRequests;
+	for (const FString& File : Files)
+	{
+		if (!ControlledFiles.Contains(File))
+		{
+			OutAdd.Add(File);
+		}
+		else if (!CheckedOutFiles.Contains(File))
+		{
+			OutCheckOut.Add(File);
+		}
+	}
+}
+
+bool FFakePackSourceControl::CheckOut(const TArray<FString>& Files)
+{
+	++NumRequests;
+	CheckedOutFiles.Append(Files);
+	UE_LOG(LogTexturePackerSave, Log, TEXT("Fake source control checked out %d files"), Files.Num());
+	return true;
+}
+
+bool FFakePackSourceControl::MarkForAdd(const TArray<FString>& Files)
+{
+	++NumRequests;
+	AddedFiles.Append(Files);
+	ControlledFiles.Append(Files);
+	UE_LOG(LogTexturePackerSave, Log, TEXT("Fake source control marked %d files for add"), Files.Num());
+	return true;
+}
+
+FPackSaveSession::FPackSaveSession(IPackSourceControl* InSourceControl) : SourceControl(InSourceControl)
+{
+	if (SourceControl == nullptr)
+	{
+		EditorSourceControl = MakeEditorSourceControl();
+		SourceControl = EditorSourceControl.Get();
+	}
+	NumRequestsAtStart = SourceControl->GetNumRequests();
+}
+
+FPackSaveSession::~FPackSaveSession()
+{
+	if (Queued.Num() > 0 || DeferredBuilds.Num() > 0)
+	{
+		Flush();
+	}
+}
+
+void FPackSaveSession::Add(UPackage* Package, UObject* Asset)
+{
+	Queued.Add({Package, Asset});
+}
+
+void FPackSaveSession::AddDeferredBuild(UTexture* Texture)
+{
+	DeferredBuilds.Add(Texture);
+}
+
+TArray<FString> FPackSaveSession::Flush()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::FlushSaveSession);
+
+	check(IsInGameThread());
+
+	TArray<FString> Failed;
+	if (Queued.Num() == 0)
+	{
+		BuildDeferred();
+		return Failed;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumRequests = SourceControl->GetNumRequests();
+
+	TArray<FString> Filenames;
+	for (const FQueuedPackage& Entry : Queued)
+	{
+		Filenames.Add(FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(
+			Entry.Package->GetName(), FPackageName::GetAssetPackageExtension())));
+	}
+
+	// Controlled files are read only until they are checked out
+	TArray<FString> FilesToCheckOut;
+	TArray<FString> FilesToAdd;
+	const bool bSourceControl = SourceControl->IsEnabled();
+	if (bSourceControl)
+	{
+		SourceControl->QueryFiles(Filenames, FilesToCheckOut, FilesToAdd);
+		if (FilesToCheckOut.Num() > 0 && !SourceControl->CheckOut(FilesToCheckOut))
+		{
+			UE_LOG(
+				LogTexturePackerSave, Warning, TEXT("Failed to check out %d packed textures"), FilesToCheckOut.Num());
+		}
+	}
+
+	// Packages are serialized one after another, their files are written in the background meanwhile
+	FSavePackageArgs SaveArgs = { nullptr, RF_Public | RF_Standalone, SAVE_Async, false,
+			true, true, FDateTime::MinValue(), GError };
+
+	TSet<FString> FailedFiles;
+	for (int32 EntryIdx = 0; EntryIdx < Queued.Num(); ++EntryIdx)
+	{
+		const FQueuedPackage& Entry = Queued[EntryIdx];
+		if (!UPackage::SavePackage(Entry.Package, Entry.Asset, *Filenames[EntryIdx], SaveArgs))
+		{
+			UE_LOG(LogTexturePackerSave, Error, TEXT("Failed to save %s"), *Entry.Package->GetName());
+			Failed.Add(Entry.Package->GetName());
+			FailedFiles.Add(Filenames[EntryIdx]);
+		}
+	}
+	UPackage::WaitForAsyncFileWrites();
+
+	FilesToAdd.RemoveAll([&FailedFiles](const FString& File) { return FailedFiles.Contains(File); });
+	if (bSourceControl && FilesToAdd.Num() > 0 && !SourceControl->MarkForAdd(FilesToAdd))
+	{
+		UE_LOG(LogTexturePackerSave, Warning, TEXT("Failed to mark %d packed textures for add"), FilesToAdd.Num());
+	}
+
+	UE_LOG(LogTexturePackerSave,
+		   Log,
+		   TEXT("Saved %d packed textures in %.2f ms, %d checked out and %d marked for add in %d source control "
+				"requests"),
+		   Queued.Num() - Failed.Num(),
+		   (FPlatformTime::Seconds() - StartTime) * 1000.0,
+		   FilesToCheckOut.Num(),
+		   FilesToAdd.Num(),
+		   SourceControl->GetNumRequests() - NumRequests);
+
+	Queued.Reset();
+	BuildDeferred();
+	return Failed;
+}
+
+void FPackSaveSession::BuildDeferred()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::BuildDeferredTextures);
+
+	if (DeferredBuilds.Num() == 0)
+	{
+		return;
+	}
+
+	// With async texture compilation every build is only queued here, so they all compress in parallel
+	const double StartTime = FPlatformTime::Seconds();
+	for (UTexture* Texture : DeferredBuilds)
+	{
+		Texture->UpdateResource();
+	}
+
+	UE_LOG(LogTexturePackerSave,
+		   Log,
+		   TEXT("Started build of %d packed textures in %.2f ms"),
+		   DeferredBuilds.Num(),
+		   (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	DeferredBuilds.Reset();
+}
+
+int32 FPackSaveSession::GetNumSourceControlRequests() const
+{
+	return SourceControl->GetNumRequests() - NumRequestsAtStart;
+}
+
+void FPackSaveSession::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FQueuedPackage& Entry : Queued)
+	{
+		Collector.AddReferencedObject(Entry.Package);
+		Collector.AddReferencedObject(Entry.Asset);
+	}
+	Collector.AddReferencedObjects(DeferredBuilds);
+}
+}  // namespace TexturePacker
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UPackage;
+class UTexture;
+
+namespace TexturePacker
+{
+/** Source control requests of a save session, every call is one request covering all given files */
+class IPackSourceControl
+{
+public:
+	virtual ~IPackSourceControl() = default;
+
+	virtual bool IsEnabled() const = 0;
+
+	/** Sort files into controlled ones that must be checked out before saving and new ones to mark for add after */
+	virtual void QueryFiles(const TArray<FString>& Files, TArray<FString>& OutCheckOut, TArray<FString>& OutAdd) = 0;
+
+	virtual bool CheckOut(const TArray<FString>& Files) = 0;
+
+	virtual bool MarkForAdd(const TArray<FString>& Files) = 0;
+
+	/** Requests sent so far */
+	virtual int32 GetNumRequests() const = 0;
+};
+
+/** Provider configured in the editor, nothing is done when source control is disabled */
+TUniquePtr<IPackSourceControl> MakeEditorSourceControl();
+
+/**
+ * @brief Local stand-in for a source control server
+ *
+ * Remembers checked out and added files and counts requests, so batching can be checked without a server. Files
+ * listed as controlled are reported for checkout, every other file for add.
+ */
+class FFakePackSourceControl final : public IPackSourceControl
+{
+public:
+	explicit FFakePackSourceControl(TSet<FString> InControlledFiles = {}) : ControlledFiles(MoveTemp(InControlledFiles))
+	{
+	}
+
+	virtual bool IsEnabled() const override
+	{
+		return true;
+	}
+
+	virtual void QueryFiles(const TArray<FString>& Files,
+							TArray<FString>& OutCheckOut,
+							TArray<FString>& OutAdd) override;
+
+	virtual bool CheckOut(const TArray<FString>& Files) override;
+
+	virtual bool MarkForAdd(const TArray<FString>& Files) override;
+
+	virtual int32 GetNumRequests() const override
+	{
+		return NumRequests;
+	}
+
+	const TSet<FString>& GetCheckedOutFiles() const
+	{
+		return CheckedOutFiles;
+	}
+
+	const TSet<FString>& GetAddedFiles() const
+	{
+		return AddedFiles;
+	}
+
+private:
+	TSet<FString> ControlledFiles;
+	TSet<FString> CheckedOutFiles;
+	TSet<FString> AddedFiles;
+	int32 NumRequests = 0;
+};
+
+/**
+ * @brief Packages saved together with one round of source control requests
+ *
+ * Packed textures are queued instead of being saved one by one. Flush checks out every queued file that needs it in
+ * one request, serializes the packages on the game thread while their files are written in the background, and marks
+ * all new files for add in one more request. Textures queued for a deferred build then all start building at once,
+ * compiled in parallel by the engine. Queued packages and textures are kept alive until they are flushed.
+ */
+class FPackSaveSession final : public FGCObject
+{
+public:
+	/** @param InSourceControl Used instead of the editor provider when set, must outlive the session */
+	explicit FPackSaveSession(IPackSourceControl* InSourceControl = nullptr);
+
+	/** Flushes packages that are still queued */
+	virtual ~FPackSaveSession() override;
+
+	/** Queue package of given asset for saving */
+	void Add(UPackage* Package, UObject* Asset);
+
+	/** Queue texture whose platform data is built once its package is saved, instead of right away */
+	void AddDeferredBuild(UTexture* Texture);
+
+	/** Save every queued package, game thread only. Returns names of packages that failed to save */
+	TArray<FString> Flush();
+
+	int32 Num() const
+	{
+		return Queued.Num();
+	}
+
+	/** Source control requests sent by this session */
+	int32 GetNumSourceControlRequests() const;
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("TexturePacker::FPackSaveSession");
+	}
+
+private:
+	/** Start building every texture queued for a deferred build */
+	void BuildDeferred();
+
+	struct FQueuedPackage
+	{
+		UPackage* Package = nullptr;
+		UObject* Asset = nullptr;
+	};
+
+	TArray<FQueuedPackage> Queued;
+	TArray<UTexture*> DeferredBuilds;
+	TUniquePtr<IPackSourceControl> EditorSourceControl;
+	IPackSourceControl* SourceControl = nullptr;
+	int32 NumRequestsAtStart = 0;
+};
+}  // namespace TexturePacker
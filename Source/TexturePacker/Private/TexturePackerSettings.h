@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "TexturePackerSettings.generated.h"
+
+/** Reconstruction filter used when a source has to be resized to the packed size */
+UENUM()
+enum class ETexturePackerResizeFilter : uint8
+{
+	/** Average of the covered source pixels */
+	Box,
+	/** Bilinear tent, smoother than box when downscaling by non integer factors */
+	Triangle,
+	/** Sharpest result, may ring around hard edges */
+	Lanczos3,
+};
+
+/** How half float values outside [0, 1] are written into 8 and 16 bit packed textures */
+UENUM()
+enum class ETexturePackerHdrMapping : uint8
+{
+	/** Values are clamped, everything above 1 is white */
+	Clamp,
+	/** Reinhard x / (1 + x), keeps detail in highlights at the cost of contrast */
+	Tonemap,
+};
+
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Texture Packer"))
+class UTexturePackerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Maximum number of threads used for pixel work while packing. 0 uses every task graph worker */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0))
+	int32 MaxWorkerThreads = 0;
+
+	/** Number of image rows processed by a single parallel task */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = 1))
+	int32 RowsPerBand = 64;
+
+	/**
+	 * Build platform data of packed textures after a batch is saved instead of right after each one is packed.
+	 * All builds of the batch start together and compress in the background while packing goes on.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Performance")
+	bool bDeferTextureBuild = true;
+
+	/** Filter used when a source has different size than the packed texture */
+	UPROPERTY(config, EditAnywhere, Category = "Quality")
+	ETexturePackerResizeFilter ResizeFilter = ETexturePackerResizeFilter::Box;
+
+	/** Mapping of HDR sources packed into 8 or 16 bit textures, RGBA16F outputs keep the full range */
+	UPROPERTY(config, EditAnywhere, Category = "Quality")
+	ETexturePackerHdrMapping HdrMapping = ETexturePackerHdrMapping::Clamp;
+
+	/**
+	 * Store the full mip chain in packed textures, every mip box filtered from the previous one in linear space.
+	 * The texture build keeps these mips instead of generating its own. Only power of two sizes get mips.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Quality")
+	bool bGenerateMips = false;
+
+	/**
+	 * Pack one source at a time in horizontal tiles instead of decoding every source up front.
+	 * Slower, but working memory next to the packed texture stays within StreamingBudgetMB.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Memory")
+	bool bStreamingPack = false;
+
+	/**
+	 * Memory for the locked source mip and tile buffers while streaming, in megabytes. Source mips are locked whole,
+	 * one bigger than the budget is packed in single row tiles with a warning.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta = (ClampMin = 1, EditCondition = "bStreamingPack"))
+	int32 StreamingBudgetMB = 256;
+
+	/** Store packed pixels in the derived data cache and reuse them when the same sources are packed again */
+	UPROPERTY(config, EditAnywhere, Category = "Cache")
+	bool bUsePackCache = true;
+
+	/** Repack packed textures when one of their sources is reimported or edited */
+	UPROPERTY(config, EditAnywhere, Category = "Auto Repack")
+	bool bAutoRepack = true;
+
+	/** Seconds sources have to stay unchanged before their packed textures are repacked, so bursts repack once */
+	UPROPERTY(config, EditAnywhere, Category = "Auto Repack", meta = (ClampMin = 0, EditCondition = "bAutoRepack"))
+	float AutoRepackDelaySeconds = 2.f;
+};
@@ -0,0 +1,267 @@
+#include "TexturePackerSourceCache.h"
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "TexturePackerKernels.h"
+#include "TexturePackerResize.h"
+
+namespace TexturePacker
+{
+namespace
+{
+template <typename ChannelType>
+void ExtractPlane(const uint8* Src, const int32 NumChannels, const int32 ChannelIdx, const int64 Num, uint8* Dst)
+{
+	const ChannelType* RESTRICT SrcChannels = reinterpret_cast<const ChannelType*>(Src) + ChannelIdx;
+	ChannelType* RESTRICT DstChannels = reinterpret_cast<ChannelType*>(Dst);
+	for (int64 PixelIdx = 0; PixelIdx < Num; ++PixelIdx)
+	{
+		DstChannels[PixelIdx] = SrcChannels[PixelIdx * NumChannels];
+	}
+}
+}  // namespace
+
+FSourceLayout GetSourceLayout(const ETextureSourceFormat Format)
+{
+	switch (Format)
+	{
+		case TSF_BGRA8:
+			return {4, 1};
+		case TSF_RGBA8:
+			return {4, 1, ESampleType::U8, true};
+		case TSF_BGRE8:
+			return {4, 1, ESampleType::U8, false, true};
+		case TSF_RGBE8:
+			return {4, 1, ESampleType::U8, true, true};
+		case TSF_RGBA16:
+			return {4, 2, ESampleType::U16, true};
+		case TSF_RGBA16F:
+			return {4, 2, ESampleType::F16, true};
+		case TSF_G8:
+			return {1, 1};
+		case TSF_G16:
+			return {1, 2, ESampleType::U16};
+		default:
+			ensureMsgf(false, TEXT("Unsupported source format %d"), int32(Format));
+			return {0, 0};
+	}
+}
+
+int32 GetSourceChannelIndex(const FSourceLayout& Layout, const EChannel Channel)
+{
+	if (Layout.NumChannels == 1)
+	{
+		return 0;
+	}
+	// EChannel follows BGRA order, red and blue swap places in RGBA pixels
+	if (Layout.bRGBAOrder && (Channel == EChannel::R || Channel == EChannel::B))
+	{
+		return 2 - int32(Channel);
+	}
+	return int32(Channel);
+}
+
+bool IsSharedExponentChannel(const FSourceLayout& Layout, const int32 ChannelIdx)
+{
+	return Layout.bSharedExponent && ChannelIdx != int32(EChannel::A);
+}
+
+ESampleType GetPlaneSampleType(const FSourceLayout& Layout, const int32 ChannelIdx)
+{
+	return IsSharedExponentChannel(Layout, ChannelIdx) ? ESampleType::F16 : Layout.SampleType;
+}
+
+bool IsHdrSourceFormat(const ETextureSourceFormat Format)
+{
+	const FSourceLayout Layout = GetSourceLayout(Format);
+	return Layout.SampleType == ESampleType::F16 || Layout.bSharedExponent;
+}
+
+FSourceMip SelectSourceMip(const FTextureSource& Source, const int32 SizeX, const int32 SizeY)
+{
+	FSourceMip Selected{0, Source.GetSizeX(), Source.GetSizeY()};
+
+	for (int32 MipIndex = 1; MipIndex < Source.GetNumMips(); ++MipIndex)
+	{
+		const int32 MipSizeX = FMath::Max(1, Source.GetSizeX() >> MipIndex);
+		const int32 MipSizeY = FMath::Max(1, Source.GetSizeY() >> MipIndex);
+		if (MipSizeX < SizeX || MipSizeY < SizeY)
+		{
+			break;
+		}
+		Selected = {MipIndex, MipSizeX, MipSizeY};
+	}
+
+	return Selected;
+}
+
+bool IsSourceChannelSRGB(const UTexture* Texture, const EChannel Channel)
+{
+	return Texture->SRGB && Channel != EChannel::A;
+}
+
+void FDecodedSourceCache::AddRequest(const FChannelOption& ChannelOption, const int32 SizeX, const int32 SizeY)
+{
+	if (ChannelOption.Texture == nullptr)
+	{
+		return;
+	}
+
+	// Sources that can't be read are never decoded, Get fails for them
+	const FSourceLayout Layout = GetSourceLayout(ChannelOption.Texture->Source.GetFormat());
+	if (!Layout.IsValid())
+	{
+		return;
+	}
+
+	FRequest& Request = Requests.FindOrAdd(ChannelOption.Texture);
+	Request.Channels.AddUnique(GetSourceChannelIndex(Layout, ChannelOption.Channel));
+	Request.Sizes.AddUnique(FIntPoint(SizeX, SizeY));
+}
+
+const FSourcePlane* FDecodedSourceCache::Get(UTexture* Texture,
+											 const EChannel Channel,
+											 const int32 SizeX,
+											 const int32 SizeY)
+{
+	check(Texture != nullptr);
+
+	const FSourceLayout Layout = GetSourceLayout(Texture->Source.GetFormat());
+	if (!Layout.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FPlaneKey Key(Texture, FIntPoint(SizeX, SizeY), GetSourceChannelIndex(Layout, Channel));
+
+	if (const TUniquePtr<FSourcePlane>* Found = Planes.Find(Key))
+	{
+		return Found->Get();
+	}
+
+	// Plane that was not requested up front costs another decode of the texture
+	FRequest& Request = Requests.FindOrAdd(Texture);
+	Request.Channels.AddUnique(Key.Get<2>());
+	Request.Sizes.AddUnique(Key.Get<1>());
+	Decode(Texture);
+
+	const TUniquePtr<FSourcePlane>* Decoded = Planes.Find(Key);
+	return Decoded != nullptr ? Decoded->Get() : nullptr;
+}
+
+void FDecodedSourceCache::Release(const UTexture* Texture)
+{
+	Requests.Remove(Texture);
+	for (auto It = Planes.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Get<0>() == Texture)
+		{
+			TrackAllocation(-It.Value()->Bytes.GetAllocatedSize());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDecodedSourceCache::Decode(UTexture* Texture)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TexturePacker::DecodeSource);
+
+	FTextureSource& Source = Texture->Source;
+	const ETextureSourceFormat Format = Source.GetFormat();
+	const FSourceLayout Layout = GetSourceLayout(Format);
+	const FRequest& Request = Requests.FindChecked(Texture);
+
+	// Existing smaller mip is cheaper to read and to resize than mip 0, as long as it covers every requested size
+	FIntPoint MaxSize(1, 1);
+	for (const FIntPoint& Size : Request.Sizes)
+	{
+		MaxSize = MaxSize.ComponentMax(Size);
+	}
+	const FSourceMip Mip = SelectSourceMip(Source, MaxSize.X, MaxSize.Y);
+
+	TArray64<uint8> Bytes;
+	Source.GetMipData(Bytes, Mip.MipIndex);
+	TrackAllocation(Bytes.GetAllocatedSize());
+
+	for (const FIntPoint& Size : Request.Sizes)
+	{
+		const int32 SizeX = Size.X;
+		const int32 SizeY = Size.Y;
+		const int64 NumPixels = int64(SizeX) * SizeY;
+		const bool bResize = Mip.SizeX != SizeX || Mip.SizeY != SizeY;
+
+		// Planes the format can't be resized to are left out, so Get fails instead of returning made up pixels
+		if (bResize && !ensureMsgf(FResampler::CanResize(Format), TEXT("Unsupported resize format")))
+		{
+			continue;
+		}
+
+		for (const int32 ChannelIdx : Request.Channels)
+		{
+			const FPlaneKey Key(Texture, Size, ChannelIdx);
+			if (Planes.Contains(Key))
+			{
+				continue;
+			}
+
+			const ESampleType PlaneType = GetPlaneSampleType(Layout, ChannelIdx);
+			const int32 PlaneBytesPerChannel = GetSampleSize(PlaneType);
+
+			TUniquePtr<FSourcePlane> Plane = MakeUnique<FSourcePlane>();
+			Plane->BytesPerChannel = PlaneBytesPerChannel;
+			Plane->SampleType = PlaneType;
+			Plane->Bytes.SetNumUninitialized(NumPixels * PlaneBytesPerChannel);
+			TrackAllocation(Plane->Bytes.GetAllocatedSize());
+
+			if (!bResize && !IsSharedExponentChannel(Layout, ChannelIdx))
+			{
+				if (Layout.BytesPerChannel == sizeof(uint16))
+				{
+					ExtractPlane<uint16>(
+						Bytes.GetData(), Layout.NumChannels, ChannelIdx, NumPixels, Plane->Bytes.GetData());
+				}
+				else
+				{
+					ExtractPlane<uint8>(
+						Bytes.GetData(), Layout.NumChannels, ChannelIdx, NumPixels, Plane->Bytes.GetData());
+				}
+			}
+			else
+			{
+				// Only this channel is resampled, straight from the interleaved source, in its own color space.
+				// Shared exponent mantissas of the same size go through a box filter, which only decodes them
+				const FResampler Resampler(
+					FResampleFormat::Channel(Format, ChannelIdx, IsSourceChannelSRGB(Texture, EChannel(ChannelIdx))),
+					Mip.SizeX,
+					Mip.SizeY,
+					SizeX,
+					SizeY,
+					bResize ? GetDefault<UTexturePackerSettings>()->ResizeFilter : ETexturePackerResizeFilter::Box);
+
+				auto ResizeRows = [&](const int32 RowStart, const int32 RowEnd)
+				{
+					Resampler.ResizeRows(Bytes.GetData() + ChannelIdx * Layout.BytesPerChannel,
+										 RowStart,
+										 RowEnd,
+										 Plane->Bytes.GetData() + int64(RowStart) * SizeX * PlaneBytesPerChannel);
+				};
+				ParallelForRowBands(SizeY, ResizeRows);
+			}
+
+			Planes.Add(Key, MoveTemp(Plane));
+		}
+	}
+
+	TrackAllocation(-Bytes.GetAllocatedSize());
+}
+
+void FDecodedSourceCache::TrackAllocation(const int64 Bytes)
+{
+	AllocatedSize += Bytes;
+	PeakAllocatedSize = FMath::Max(PeakAllocatedSize, AllocatedSize);
+}
+
+int64 FDecodedSourceCache::GetAllocatedSize() const
+{
+	return AllocatedSize;
+}
+}  // namespace TexturePacker
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+#include "TexturePacker.h"
+#include "TexturePackerKernels.h"
+
+namespace TexturePacker
+{
+/** How channels of a source format are laid out in memory */
+struct FSourceLayout
+{
+	int32 NumChannels = 4;
+	int32 BytesPerChannel = 1;
+	ESampleType SampleType = ESampleType::U8;
+	/** Red comes first in memory, otherwise pixels are stored in BGRA order */
+	bool bRGBAOrder = false;
+	/** Red, green and blue are mantissas of the exponent stored in alpha */
+	bool bSharedExponent = false;
+
+	/** Unsupported formats have no channels, sources in them are never read */
+	bool IsValid() const
+	{
+		return NumChannels > 0;
+	}
+};
+
+/** Layout of given format, invalid for formats the packer can't read */
+FSourceLayout GetSourceLayout(const ETextureSourceFormat Format);
+
+/** Index of given channel among the channels of a source pixel */
+int32 GetSourceChannelIndex(const FSourceLayout& Layout, const EChannel Channel);
+
+/** Whether given source channel is a shared exponent mantissa, those are always decoded through FResampler */
+bool IsSharedExponentChannel(const FSourceLayout& Layout, const int32 ChannelIdx);
+
+/** Type of decoded samples of given source channel, shared exponent mantissas decode to halves */
+ESampleType GetPlaneSampleType(const FSourceLayout& Layout, const int32 ChannelIdx);
+
+/** Whether given source format holds values above one, packing it defaults to RGBA16F */
+bool IsHdrSourceFormat(const ETextureSourceFormat Format);
+
+/** Source mip to read for given target size, with its dimensions */
+struct FSourceMip
+{
+	int32 MipIndex = 0;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+};
+
+/** Smallest existing source mip that is not smaller than given size in either dimension */
+FSourceMip SelectSourceMip(const FTextureSource& Source, const int32 SizeX, const int32 SizeY);
+
+/** Whether given channel of a texture is stored in sRGB. Alpha is always linear */
+bool IsSourceChannelSRGB(const UTexture* Texture, const EChannel Channel);
+
+/** Single channel of a source texture, decoded, resized to the pack size and tightly packed */
+struct FSourcePlane
+{
+	TArray64<uint8> Bytes;
+	int32 BytesPerChannel = 1;
+	ESampleType SampleType = ESampleType::U8;
+};
+
+/**
+ * @brief Decoded source channels shared by all channels of a pack
+ *
+ * Only the channels that are read are kept, as compact 8 or 16 bit planes. Every texture is decoded once for all of
+ * its requested channels and sizes and the full mip is freed as soon as they are extracted. A cache may be shared by
+ * many packs, in which case planes stay until their texture is released.
+ */
+class FDecodedSourceCache
+{
+public:
+	/** Register channel that will be read at given size, so a single decode extracts all planes of the texture */
+	void AddRequest(const FChannelOption& ChannelOption, const int32 SizeX, const int32 SizeY);
+
+	/**
+	 * @brief Get plane of given texture channel at given size, decoding the texture on the first request
+	 *
+	 * Returned plane stays valid for the lifetime of the cache.
+	 *
+	 * @return Null when the texture can't be decoded at given size, its source format can't be resized
+	 */
+	const FSourcePlane* Get(UTexture* Texture, const EChannel Channel, const int32 SizeX, const int32 SizeY);
+
+	/** Drop all planes and requests of given texture, references returned by Get for it become invalid */
+	void Release(const UTexture* Texture);
+
+	int32 Num() const
+	{
+		return Planes.Num();
+	}
+
+	/** Bytes held by all decoded planes */
+	int64 GetAllocatedSize() const;
+
+	/** Highest number of bytes held at once, including full mips that were decoded temporarily */
+	int64 GetPeakAllocatedSize() const
+	{
+		return PeakAllocatedSize;
+	}
+
+	/** Start measuring peak from the bytes held now, used when the cache is shared by several packs */
+	void ResetPeakAllocatedSize()
+	{
+		PeakAllocatedSize = AllocatedSize;
+	}
+
+private:
+	using FPlaneKey = TTuple<const UTexture*, FIntPoint, int32>;
+
+	/** Channels of a texture that will be read and the sizes they will be read at */
+	struct FRequest
+	{
+		TArray<int32, TInlineAllocator<4>> Channels;
+		TArray<FIntPoint, TInlineAllocator<2>> Sizes;
+	};
+
+	/** Extract every requested plane of the texture, sizes its source format can't be resized to get no planes */
+	void Decode(UTexture* Texture);
+
+	void TrackAllocation(const int64 Bytes);
+
+	TMap<const UTexture*, FRequest> Requests;
+	TMap<FPlaneKey, TUniquePtr<FSourcePlane>> Planes;
+	int64 AllocatedSize = 0;
+	int64 PeakAllocatedSize = 0;
+};
+}  // namespace TexturePacker
@@ -16,6 +16,22 @@ enum class EChannel
 	Black
 };
 
+/** Pixel format of a packed texture */
+enum class EPackFormat : uint8
+{
+	/**
+	 * Picked from the packed channels. RGBA16F when any source is half float or RGBE. Otherwise packs without alpha
+	 * whose green and blue read the same as red get G8 and the rest BGRA8, or G16 and RGBA16 when any source is 16 bit
+	 */
+	Auto,
+	BGRA8,
+	/** Single channel formats pack only the red channel */
+	G8,
+	G16,
+	RGBA16,
+	RGBA16F
+};
+
 struct FChannelOption
 {
 	FChannelOption(UTexture* InTexture, EChannel InChannel, bool bInInvert = false, bool bInKeepSrgb = false)
@@ -34,5 +50,29 @@ TEXTUREPACKER_API UTexture* PackTexture(const TCHAR* PackagePath,
 										const FChannelOption Red,
 										const FChannelOption Green,
 										const FChannelOption Blue,
-										TOptional<FChannelOption> Alpha);
+										TOptional<FChannelOption> Alpha,
+										const EPackFormat Format = EPackFormat::BGRA8);
+
+/** One texture of a multi output pack */
+struct FPackOutput
+{
+	FString TextureName;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	FChannelOption Red{nullptr, EChannel::Black};
+	FChannelOption Green{nullptr, EChannel::Black};
+	FChannelOption Blue{nullptr, EChannel::Black};
+	TOptional<FChannelOption> Alpha;
+	EPackFormat Format = EPackFormat::BGRA8;
+};
+
+/**
+ * @brief Pack several textures into the same path from one selection of sources
+ *
+ * Every source is decoded once for all outputs and outputs of the same size are filled in a single pass, so packing
+ * several textures costs about as much as decoding their sources once.
+ *
+ * @return Packed texture of every output in output order, null for outputs that failed
+ */
+TEXTUREPACKER_API TArray<UTexture*> PackTextures(const TCHAR* PackagePath, const TArray<FPackOutput>& Outputs);
 }  // namespace TexturePacker
\ No newline at end of file
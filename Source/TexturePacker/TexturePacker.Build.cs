@@ -11,12 +11,17 @@ namespace UnrealBuildTool.Rules
 			PrivateDependencyModuleNames.AddRange(
 				new string[]
 				{
+					"AssetRegistry",
 					"Core",
 					"CoreUObject",
+					"DerivedDataCache",
+					"DeveloperSettings",
 					"Engine",
 					"InputCore",
+					"Json",
 					"Slate",
 					"SlateCore",
+					"SourceControl",
 					"UnrealEd",
 				}
 			);